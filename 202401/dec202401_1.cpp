@@ -3,37 +3,125 @@
 //
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
 #include <functional>
-#include <iostream>
 #include <print>
-#include <ranges>
+#include <span>
 #include <vector>
 
-int main()
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#endif
+
+#include "input.h"
+#include "radix_sort.h"
+#include "solver.h"
+#include "thread_pool.h"
+
+namespace {
+
+// Location IDs are five digits, so int is plenty
+struct Lists {
+	std::vector<int> left_numbers;
+	std::vector<int> right_numbers;
+};
+
+Lists parse(aoc::Scanner &in)
 {
-	std::vector<long> left_numbers;
-	std::vector<long> right_numbers;
+	Lists lists;
+
+	auto num_lines = std::ranges::count(in.remaining(), '\n') + 1;
 
-	for (long left = 0, right = 0; std::cin >> left >> right; ) {
-		left_numbers.push_back(left);
-		right_numbers.push_back(right);
+	lists.left_numbers.reserve(num_lines);
+	lists.right_numbers.reserve(num_lines);
+
+	for (int left = 0, right = 0; in.next(left, right); ) {
+		lists.left_numbers.push_back(left);
+		lists.right_numbers.push_back(right);
 	}
 
-	std::ranges::sort(left_numbers);
-	std::ranges::sort(right_numbers);
+	return lists;
+}
+
+// Sum of the absolute differences between left and right, the numbers are
+// non-negative so the differences fit in an int
+long sum_distances(std::span<const int> left, std::span<const int> right)
+{
+	auto size = std::min(left.size(), right.size());
+
+	std::size_t i = 0;
 
-	auto total_distance = std::ranges::fold_left(
-		std::views::zip_transform(
-			[](auto left, auto right) {
-				return std::abs(right - left);
-			},
-			left_numbers,
-			right_numbers
+	long total = 0;
 
-		),
-		0L,
-		std::plus{}
-	);
+#if defined(__AVX2__)
+	__m256i sums = _mm256_setzero_si256();
+
+	for (; i + 8 <= size; i += 8) {
+		auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(left.data() + i));
+		auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(right.data() + i));
+
+		auto distances = _mm256_abs_epi32(_mm256_sub_epi32(a, b));
+
+		// Add in 64-bit lanes so the sum cannot overflow
+		sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(distances)));
+		sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(distances, 1)));
+	}
+
+	alignas(32) std::array<long long, 4> lanes;
+
+	_mm256_store_si256(reinterpret_cast<__m256i *>(lanes.data()), sums);
+
+	total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+	for (; i < size; ++i) {
+		total += std::abs(right[i] - left[i]);
+	}
 
-	std::println("total distance is {}", total_distance);
+	return total;
 }
+
+// Lists at least this long are sorted and summed using all cores
+constexpr std::size_t min_parallel_size = std::size_t{1} << 20;
+
+long solve(Lists lists)
+{
+	auto &[left_numbers, right_numbers] = lists;
+
+	if (!aoc::use_parallel(left_numbers.size(), min_parallel_size)) {
+		aoc::radix_sort(left_numbers);
+		aoc::radix_sort(right_numbers);
+
+		return sum_distances(left_numbers, right_numbers);
+	}
+
+	auto &pool = aoc::shared_pool();
+
+	// Sort the lists concurrently, an exception from either is rethrown here
+	aoc::parallel_for(pool, 2, 2, [&](auto chunk, auto, auto) {
+		aoc::radix_sort(chunk == 0 ? left_numbers : right_numbers);
+	});
+
+	auto size = std::min(left_numbers.size(), right_numbers.size());
+
+	std::vector<long> totals(pool.size(), 0);
+
+	aoc::parallel_for(pool, size, totals.size(), [&](auto chunk, auto begin, auto end) {
+		totals[chunk] = sum_distances(std::span(left_numbers).subspan(begin, end - begin),
+		                              std::span(right_numbers).subspan(begin, end - begin));
+	});
+
+	return std::ranges::fold_left(totals, 0L, std::plus{});
+}
+
+void print(std::FILE *out, long total_distance)
+{
+	std::println(out, "total distance is {}", total_distance);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -4,23 +4,117 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
 #include <print>
+#include <span>
+#include <utility>
 #include <vector>
 
-int main()
+#include "input.h"
+#include "radix_sort.h"
+#include "solver.h"
+#include "thread_pool.h"
+
+namespace {
+
+// Location IDs are five digits, so int is plenty
+struct Lists {
+	std::vector<int> left_numbers;
+	std::vector<int> right_numbers;
+};
+
+Lists parse(aoc::Scanner &in)
+{
+	Lists lists;
+
+	auto num_lines = std::ranges::count(in.remaining(), '\n') + 1;
+
+	lists.left_numbers.reserve(num_lines);
+	lists.right_numbers.reserve(num_lines);
+
+	for (int left = 0, right = 0; in.next(left, right); ) {
+		lists.left_numbers.push_back(left);
+		lists.right_numbers.push_back(right);
+	}
+
+	return lists;
+}
+
+// Call fn(chunk, begin, end) for num_chunks ranges covering [0, size), on
+// the pool if there is one. An exception thrown by fn on the pool is
+// rethrown here once all chunks are done, like it would be without one.
+template<typename Fn>
+void for_chunks(aoc::ThreadPool *pool, std::size_t size, std::size_t num_chunks, Fn fn)
+{
+	if (pool != nullptr) {
+		aoc::parallel_for(*pool, size, num_chunks, fn);
+	}
+	else {
+		fn(std::size_t{0}, std::size_t{0}, size);
+	}
+}
+
+// Most memory used by the count tables of all chunks together
+constexpr std::size_t max_count_bytes = std::size_t{1} << 24;
+
+// Count number of occurences of each number in right list in a table
+// indexed by number, each chunk counting into a table of its own
+//
+// Large tables are counted by fewer chunks, so the tables together stay
+// within max_count_bytes.
+long similarity_by_counting(const Lists &lists, int max_right, aoc::ThreadPool *pool)
 {
-	std::vector<long> left_numbers;
-	std::vector<long> right_numbers;
+	const auto &[left_numbers, right_numbers] = lists;
+
+	auto num_chunks = pool != nullptr ? pool->size() : 1;
+
+	auto table_bytes = (static_cast<std::size_t>(max_right) + 1) * sizeof(std::uint32_t);
+
+	auto num_tables = std::clamp<std::size_t>(max_count_bytes / table_bytes, 1, num_chunks);
+
+	std::vector<std::vector<std::uint32_t>> chunk_counts(num_tables);
+
+	for_chunks(pool, right_numbers.size(), num_tables, [&](auto chunk, auto begin, auto end) {
+		auto &counts = chunk_counts[chunk];
+
+		counts.assign(max_right + 1, 0);
+
+		for (auto right : std::span(right_numbers).subspan(begin, end - begin)) {
+			++counts[right];
+		}
+	});
 
-	for (long left = 0, right = 0; std::cin >> left >> right; ) {
-		left_numbers.push_back(left);
-		right_numbers.push_back(right);
+	auto &counts = chunk_counts.front();
+
+	if (num_tables > 1) {
+		for_chunks(pool, counts.size(), num_chunks, [&](auto, auto begin, auto end) {
+			for (std::size_t chunk = 1; chunk < num_tables; ++chunk) {
+				for (auto i = begin; i < end; ++i) {
+					counts[i] += chunk_counts[chunk][i];
+				}
+			}
+		});
 	}
 
-	std::ranges::sort(left_numbers);
-	std::ranges::sort(right_numbers);
+	std::vector<long> scores(num_chunks, 0);
+
+	for_chunks(pool, left_numbers.size(), num_chunks, [&](auto chunk, auto begin, auto end) {
+		for (auto left : std::span(left_numbers).subspan(begin, end - begin)) {
+			if (left >= 0 && left <= max_right) {
+				scores[chunk] += static_cast<long>(left) * counts[left];
+			}
+		}
+	});
+
+	return std::ranges::fold_left(scores, 0L, std::plus{});
+}
 
+// Similarity score of sorted lists, where the left list contains whole runs
+// of equal numbers
+long merge_similarity(std::span<const int> left_numbers, std::span<const int> right_numbers)
+{
 	long similarity_score = 0;
 
 	for (std::size_t i = 0, j = 0; i < left_numbers.size(); ++i) {
@@ -48,5 +142,87 @@ int main()
 		similarity_score += left_num_equal * right_num_equal * left_numbers[i];
 	}
 
-	std::println("similarity score is {}", similarity_score);
+	return similarity_score;
 }
+
+// Sort both lists and merge them, for numbers too large to count in a table
+//
+// Each chunk of the left list is moved back to the start of the run of
+// equal numbers it begins in, and merged with the part of the right list
+// from the first number that can match, both found by binary search.
+long similarity_by_merge(Lists lists, aoc::ThreadPool *pool)
+{
+	auto &[left_numbers, right_numbers] = lists;
+
+	// Sort the lists concurrently if there is a pool
+	for_chunks(pool, 2, pool != nullptr ? 2 : 1, [&](auto, auto begin, auto end) {
+		for (auto i = begin; i < end; ++i) {
+			aoc::radix_sort(i == 0 ? left_numbers : right_numbers);
+		}
+	});
+
+	auto num_chunks = pool != nullptr ? pool->size() : 1;
+
+	std::vector<long> scores(num_chunks, 0);
+
+	auto run_start = [&](std::size_t i) {
+		if (i == left_numbers.size()) {
+			return left_numbers.end();
+		}
+
+		return std::lower_bound(left_numbers.begin(), left_numbers.begin() + i, left_numbers[i]);
+	};
+
+	for_chunks(pool, left_numbers.size(), num_chunks, [&](auto chunk, auto begin, auto end) {
+		auto first = run_start(begin);
+		auto last = run_start(end);
+
+		if (first == last) {
+			return;
+		}
+
+		auto right_first = std::ranges::lower_bound(right_numbers, *first);
+		auto right_last = last != left_numbers.end() ? std::lower_bound(right_first, right_numbers.end(), *last)
+		                                             : right_numbers.end();
+
+		scores[chunk] = merge_similarity(std::span(first, last), std::span(right_first, right_last));
+	});
+
+	return std::ranges::fold_left(scores, 0L, std::plus{});
+}
+
+// Largest number counted in a table indexed by number
+constexpr int max_table_number = 1 << 22;
+
+// Lists at least this long are processed using all cores
+constexpr std::size_t min_parallel_size = std::size_t{1} << 20;
+
+long solve(Lists lists)
+{
+	if (lists.left_numbers.empty() || lists.right_numbers.empty()) {
+		return 0;
+	}
+
+	aoc::ThreadPool *pool = nullptr;
+
+	if (aoc::use_parallel(lists.right_numbers.size(), min_parallel_size)) {
+		pool = &aoc::shared_pool();
+	}
+
+	auto [min_right, max_right] = std::ranges::minmax(lists.right_numbers);
+
+	if (min_right >= 0 && max_right <= max_table_number) {
+		return similarity_by_counting(lists, max_right, pool);
+	}
+
+	return similarity_by_merge(std::move(lists), pool);
+}
+
+void print(std::FILE *out, long similarity_score)
+{
+	std::println(out, "similarity score is {}", similarity_score);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
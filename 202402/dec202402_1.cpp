@@ -3,15 +3,21 @@
 //
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
 #include <functional>
-#include <iostream>
-#include <iterator>
 #include <print>
 #include <ranges>
-#include <sstream>
-#include <string>
+#include <string_view>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+#include "thread_pool.h"
+
+namespace {
+
 bool is_valid(const auto &report)
 {
 	if (!(std::ranges::is_sorted(report) || std::ranges::is_sorted(report, std::greater<>{}))) {
@@ -29,18 +35,88 @@ bool is_valid(const auto &report)
 	return true;
 }
 
-int main()
-{
+// Safe reports out of those checked
+struct Tally {
 	long num_valid = 0;
+	long num_reports = 0;
+
+	// Reports per second are shown with --time
+	long items() const { return num_reports; }
+};
+
+// Check the reports in text one line at a time, reading the levels of each
+// into the same buffer
+Tally check_reports(std::string_view text)
+{
+	Tally tally;
+
+	// Levels are small, so int is plenty
+	std::vector<int> levels;
+
+	aoc::Scanner in(text);
+
+	for (std::string_view line; in.getline(line); ) {
+		if (line.empty()) {
+			continue;
+		}
+
+		levels.clear();
+
+		aoc::Scanner numbers(line);
+
+		for (int level = 0; numbers.next(level); ) {
+			levels.push_back(level);
+		}
+
+		++tally.num_reports;
+		tally.num_valid += is_valid(levels);
+	}
+
+	return tally;
+}
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::istringstream is(line);
+// Inputs at least this many bytes are split into chunks checked on all cores
+constexpr std::size_t min_parallel_size = std::size_t{1} << 20;
 
-		std::vector<long> report(std::istream_iterator<long>{is},
-		                         std::istream_iterator<long>{});
+// The reports are checked straight from the input text by solve
+aoc::Unparsed parse(aoc::Scanner &in)
+{
+	return {in.remaining()};
+}
+
+Tally solve(aoc::Unparsed input)
+{
+	auto text = input.text;
 
-		num_valid += is_valid(report);
+	if (!aoc::use_parallel(text.size(), min_parallel_size)) {
+		return check_reports(text);
 	}
 
-	std::println("{} valid reports", num_valid);
+	auto &pool = aoc::shared_pool();
+
+	auto chunks = aoc::split_lines(text, pool.size());
+
+	std::vector<Tally> tallies(chunks.size());
+
+	aoc::parallel_for(pool, chunks.size(), chunks.size(), [&](auto chunk, auto, auto) {
+		tallies[chunk] = check_reports(chunks[chunk]);
+	});
+
+	Tally total;
+
+	for (const auto &[num_valid, num_reports] : tallies) {
+		total.num_valid += num_valid;
+		total.num_reports += num_reports;
+	}
+
+	return total;
+}
+
+void print(std::FILE *out, const Tally &tally)
+{
+	std::println(out, "{} valid reports", tally.num_valid);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
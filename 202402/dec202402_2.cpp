@@ -3,61 +3,223 @@
 //
 
 #include <algorithm>
-#include <functional>
-#include <iostream>
-#include <iterator>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
 #include <print>
-#include <ranges>
-#include <sstream>
-#include <string>
+#include <span>
+#include <string_view>
 #include <vector>
 
-bool is_valid(const auto &report)
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#endif
+
+#include "input.h"
+#include "solver.h"
+#include "thread_pool.h"
+
+namespace {
+
+// Whether going from level a to level b is a change of 1 to 3 in the
+// direction given by the sign of direction
+constexpr bool is_safe_step(int a, int b, int direction)
 {
-	if (!(std::ranges::is_sorted(report) || std::ranges::is_sorted(report, std::greater<>{}))) {
-		return false;
-	}
+	auto difference = (b - a) * direction;
 
-	for (auto [a, b] : std::views::adjacent<2>(report)) {
-		auto difference = std::abs(b - a);
+	return difference >= 1 && difference <= 3;
+}
+
+// Whether every step in direction is safe with the level at index skip removed
+bool is_safe_without(std::span<const int> levels, std::size_t skip, int direction)
+{
+	std::size_t prev = skip == 0 ? 1 : 0;
+
+	for (std::size_t i = prev + 1; i < levels.size(); ++i) {
+		if (i == skip) {
+			continue;
+		}
 
-		if (difference < 1 || difference > 3) {
+		if (!is_safe_step(levels[prev], levels[i], direction)) {
 			return false;
 		}
+
+		prev = i;
 	}
 
 	return true;
 }
 
-int main()
+// Whether every step in direction is safe after removing at most one level.
+// Removing any other level leaves the first unsafe step in place, so only
+// its two ends are candidates, which keeps this linear.
+bool is_safe_dampened(std::span<const int> levels, int direction)
+{
+	for (std::size_t i = 1; i < levels.size(); ++i) {
+		if (!is_safe_step(levels[i - 1], levels[i], direction)) {
+			return is_safe_without(levels, i - 1, direction)
+			    || is_safe_without(levels, i, direction);
+		}
+	}
+
+	return true;
+}
+
+#if defined(__AVX2__)
+// Reports with up to this many levels fit in one vector
+constexpr std::size_t max_simd_levels = 8;
+
+// Mask with bit i set if lane i is in the range 1 to 3
+unsigned safe_lanes(__m256i differences)
 {
+	auto in_range = _mm256_and_si256(_mm256_cmpgt_epi32(differences, _mm256_setzero_si256()),
+	                                 _mm256_cmpgt_epi32(_mm256_set1_epi32(4), differences));
+
+	return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(in_range)));
+}
+
+// Same as is_safe_dampened() in both directions, for 2 to max_simd_levels
+// levels. The steps from each level to the next and to the one after are
+// computed eight at a time, and turned into masks of the safe ones.
+bool is_safe_dampened_simd(std::span<const int> levels)
+{
+	alignas(32) std::array<int, max_simd_levels + 2> padded = {};
+
+	std::ranges::copy(levels, padded.begin());
+
+	auto first = _mm256_load_si256(reinterpret_cast<const __m256i *>(padded.data()));
+	auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(padded.data() + 1));
+	auto third = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(padded.data() + 2));
+
+	auto steps = _mm256_sub_epi32(second, first);
+	auto skips = _mm256_sub_epi32(third, first);
+
+	auto num_levels = levels.size();
+
+	unsigned step_mask = (1U << (num_levels - 1)) - 1;
+
+	auto check = [&](unsigned safe_steps, unsigned safe_skips) {
+		unsigned unsafe = ~safe_steps & step_mask;
+
+		if (unsafe == 0) {
+			return true;
+		}
+
+		// Removing level j drops steps j - 1 and j, and for levels inside
+		// the report adds the step from level j - 1 to j + 1
+		auto can_remove = [&](std::size_t j) {
+			unsigned dropped = (3U << j) >> 1;
+
+			return (unsafe & ~dropped) == 0
+			    && (j == 0 || j == num_levels - 1 || (safe_skips >> (j - 1)) & 1);
+		};
+
+		auto first_unsafe = static_cast<std::size_t>(std::countr_zero(unsafe));
+
+		return can_remove(first_unsafe) || can_remove(first_unsafe + 1);
+	};
+
+	auto zero = _mm256_setzero_si256();
+
+	return check(safe_lanes(steps), safe_lanes(skips))
+	    || check(safe_lanes(_mm256_sub_epi32(zero, steps)), safe_lanes(_mm256_sub_epi32(zero, skips)));
+}
+#endif
+
+bool is_safe_dampened(std::span<const int> levels)
+{
+#if defined(__AVX2__)
+	if (levels.size() >= 2 && levels.size() <= max_simd_levels) {
+		return is_safe_dampened_simd(levels);
+	}
+#endif
+
+	return is_safe_dampened(levels, 1) || is_safe_dampened(levels, -1);
+}
+
+// Safe reports out of those checked
+struct Tally {
 	long num_valid = 0;
+	long num_reports = 0;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::istringstream is(line);
+	// Reports per second are shown with --time
+	long items() const { return num_reports; }
+};
 
-		std::vector<long> report(std::istream_iterator<long>{is},
-		                         std::istream_iterator<long>{});
+// Check the reports in text one line at a time, reading the levels of each
+// into the same buffer
+Tally check_reports(std::string_view text)
+{
+	Tally tally;
 
-		if (is_valid(report)) {
-			++num_valid;
+	// Levels are small, so int is plenty
+	std::vector<int> levels;
+
+	aoc::Scanner in(text);
+
+	for (std::string_view line; in.getline(line); ) {
+		if (line.empty()) {
+			continue;
 		}
-		else {
-			for (auto it = report.begin(); it != report.end(); ++it) {
-				std::vector<long> report_without_it;
 
-				report_without_it.reserve(report.size());
+		levels.clear();
 
-				report_without_it.assign(report.begin(), it);
-				report_without_it.insert(report_without_it.end(), it + 1, report.end());
+		aoc::Scanner numbers(line);
 
-				if (is_valid(report_without_it)) {
-					++num_valid;
-					break;
-				}
-			}
+		for (int level = 0; numbers.next(level); ) {
+			levels.push_back(level);
 		}
+
+		++tally.num_reports;
+		tally.num_valid += is_safe_dampened(levels);
+	}
+
+	return tally;
+}
+
+// Inputs at least this many bytes are split into chunks checked on all cores
+constexpr std::size_t min_parallel_size = std::size_t{1} << 20;
+
+// The reports are checked straight from the input text by solve
+aoc::Unparsed parse(aoc::Scanner &in)
+{
+	return {in.remaining()};
+}
+
+Tally solve(aoc::Unparsed input)
+{
+	auto text = input.text;
+
+	if (!aoc::use_parallel(text.size(), min_parallel_size)) {
+		return check_reports(text);
 	}
 
-	std::println("{} valid reports", num_valid);
+	auto &pool = aoc::shared_pool();
+
+	auto chunks = aoc::split_lines(text, pool.size());
+
+	std::vector<Tally> tallies(chunks.size());
+
+	aoc::parallel_for(pool, chunks.size(), chunks.size(), [&](auto chunk, auto, auto) {
+		tallies[chunk] = check_reports(chunks[chunk]);
+	});
+
+	Tally total;
+
+	for (const auto &[num_valid, num_reports] : tallies) {
+		total.num_valid += num_valid;
+		total.num_reports += num_reports;
+	}
+
+	return total;
+}
+
+void print(std::FILE *out, const Tally &tally)
+{
+	std::println(out, "{} valid reports", tally.num_valid);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
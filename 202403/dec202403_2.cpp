@@ -2,49 +2,378 @@
 // Advent of Code 2024, day 3, part two
 //
 
-#include <iostream>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
 #include <print>
-#include <regex>
-#include <string>
+#include <string_view>
 
-int main()
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+struct Result {
+	std::size_t memory_size = 0;
+	long total = 0;
+};
+
+// Whether c can start an instruction or a line break
+constexpr bool is_candidate(char c)
 {
-	std::string memory;
+	return c == 'm' || c == 'd' || c == '\n' || c == '\r';
+}
+
+// Position of the first candidate at or after pos, or the end of text
+std::size_t find_candidate(std::string_view text, std::size_t pos)
+{
+#if defined(__SSE2__)
+	const auto m = _mm_set1_epi8('m');
+	const auto d = _mm_set1_epi8('d');
+	const auto lf = _mm_set1_epi8('\n');
+	const auto cr = _mm_set1_epi8('\r');
+
+	for (; pos + 16 <= text.size(); pos += 16) {
+		auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text.data() + pos));
+
+		auto hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, m), _mm_cmpeq_epi8(chars, d)),
+		                         _mm_or_si128(_mm_cmpeq_epi8(chars, lf), _mm_cmpeq_epi8(chars, cr)));
+
+		if (auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits)); mask != 0) {
+			return pos + std::countr_zero(mask);
+		}
+	}
+#endif
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		memory.append(line);
+	while (pos < text.size() && !is_candidate(text[pos])) {
+		++pos;
 	}
 
-	std::println("memory size is '{}'", memory.size());
+	return pos;
+}
 
-	// Replace memory between don't() and do() with spaces
-	for (std::string::size_type start = 0; ; ) {
-		start = memory.find("don't()", start);
+constexpr bool is_line_break(char c)
+{
+	return c == '\n' || c == '\r';
+}
 
-		if (start == std::string::npos) {
-			break;
+constexpr bool is_digit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+// Result of comparing the text at a position to an expected word
+enum class Match { yes, no, unknown };
+
+// Compare rest from i to word, moving i past the bytes that match. The
+// result is unknown if a line break or the end of rest comes first.
+Match match_word(std::string_view rest, std::size_t &i, std::string_view word)
+{
+	for (char expected : word) {
+		if (i == rest.size() || is_line_break(rest[i])) {
+			return Match::unknown;
+		}
+
+		if (rest[i] != expected) {
+			return Match::no;
 		}
 
-		auto end = memory.find("do()", start);
+		++i;
+	}
 
-		if (end == std::string::npos) {
-			end = memory.size();
+	return Match::yes;
+}
+
+// State machine that sums the enabled mul(a,b) instructions in one pass.
+//
+// The memory is the lines of the input joined, up to the first empty line,
+// so line breaks are skipped and instructions may continue on the next
+// line. Outside instructions the scanner jumps between candidate bytes with
+// find_candidate(), and match() reads most instructions in one go. Those
+// that reach a line break or the end of a block are stepped through one
+// byte at a time.
+class MemoryScanner {
+public:
+	// Scan text, returns false once the memory has ended at an empty line
+	bool scan(std::string_view text)
+	{
+		for (std::size_t pos = 0; pos < text.size() && !ended; ++pos) {
+			if (state == State::start && !pending_cr) {
+				auto next = find_candidate(text, pos);
+
+				if (next != pos) {
+					size += next - pos;
+					at_line_start = false;
+					pos = next;
+
+					if (pos == text.size()) {
+						break;
+					}
+				}
+
+				if (auto length = match(text.substr(pos)); length != 0) {
+					pos += length - 1;
+					continue;
+				}
+			}
+
+			consume(text[pos]);
 		}
 
-		memory.replace(start, end - start, end - start, ' ');
+		return !ended;
+	}
+
+	Result result() const { return {size, total}; }
+
+private:
+	enum class State {
+		start, m, mu, mul, first, second, d, do_, do_open, don, don_, don_t, don_t_open
+	};
+
+	// Read the instruction rest starts with, or the bytes that show it is
+	// not one. Returns the number of bytes consumed, or 0 to leave it to
+	// the state machine.
+	std::size_t match(std::string_view rest)
+	{
+		std::size_t i = 0;
+
+		auto result = rest[0] == 'm' ? match_mul(rest, i)
+		            : rest[0] == 'd' ? match_do(rest, i)
+		            : Match::unknown;
+
+		if (result == Match::unknown) {
+			return 0;
+		}
 
-		start = end;
+		size += i;
+		at_line_start = false;
+
+		return i;
 	}
 
-	const std::regex mul_re(R"=(mul\((\d{1,3}),(\d{1,3})\))=");
+	Match match_mul(std::string_view rest, std::size_t &i)
+	{
+		if (auto result = match_word(rest, i, "mul("); result != Match::yes) {
+			return result;
+		}
 
-	long total = 0;
+		long operands[2] = {};
+
+		for (int k = 0; k < 2; ++k) {
+			int num_digits = 0;
+
+			for (; i < rest.size() && is_digit(rest[i]) && num_digits < 3; ++i, ++num_digits) {
+				operands[k] = operands[k] * 10 + (rest[i] - '0');
+			}
+
+			if (i == rest.size() || is_line_break(rest[i])) {
+				return Match::unknown;
+			}
 
-	for (std::sregex_iterator it(memory.begin(), memory.end(), mul_re), it_end; it != it_end; ++it) {
-		const std::smatch &match = *it;
+			if (num_digits == 0 || is_digit(rest[i])) {
+				return Match::no;
+			}
 
-		total += std::stol(match[1].str()) * std::stol(match[2].str());
+			if (auto result = match_word(rest, i, k == 0 ? "," : ")"); result != Match::yes) {
+				return result;
+			}
+		}
+
+		if (enabled) {
+			total += operands[0] * operands[1];
+		}
+
+		return Match::yes;
 	}
 
-	std::println("total is {}", total);
+	// Match do() or don't()
+	Match match_do(std::string_view rest, std::size_t &i)
+	{
+		if (auto result = match_word(rest, i, "do"); result != Match::yes) {
+			return result;
+		}
+
+		if (i == rest.size() || is_line_break(rest[i])) {
+			return Match::unknown;
+		}
+
+		bool is_do = rest[i] == '(';
+
+		auto result = match_word(rest, i, is_do ? "()" : "n't()");
+
+		if (result == Match::yes) {
+			enabled = is_do;
+		}
+
+		return result;
+	}
+
+	void consume(char c)
+	{
+		// Like aoc::Scanner::getline, a carriage return right before a
+		// newline or at the end of input is part of the line ending, any
+		// other carriage return is part of the memory
+		if (pending_cr) {
+			pending_cr = false;
+
+			if (c != '\n') {
+				++size;
+				at_line_start = false;
+				state = State::start;
+			}
+		}
+
+		if (c == '\n') {
+			ended = at_line_start;
+			at_line_start = true;
+			return;
+		}
+
+		if (c == '\r') {
+			pending_cr = true;
+			return;
+		}
+
+		++size;
+		at_line_start = false;
+
+		step(c);
+	}
+
+	void step(char c)
+	{
+		switch (state) {
+		case State::m: return expect(c, 'u', State::mu);
+		case State::mu: return expect(c, 'l', State::mul);
+		case State::mul:
+			if (c == '(') {
+				state = State::first;
+				num_digits = 0;
+				first = 0;
+				return;
+			}
+			break;
+		case State::first:
+			if (c >= '0' && c <= '9' && num_digits < 3) {
+				first = first * 10 + (c - '0');
+				++num_digits;
+				return;
+			}
+			if (c == ',' && num_digits > 0) {
+				state = State::second;
+				num_digits = 0;
+				second = 0;
+				return;
+			}
+			break;
+		case State::second:
+			if (c >= '0' && c <= '9' && num_digits < 3) {
+				second = second * 10 + (c - '0');
+				++num_digits;
+				return;
+			}
+			if (c == ')' && num_digits > 0) {
+				if (enabled) {
+					total += first * second;
+				}
+				state = State::start;
+				return;
+			}
+			break;
+		case State::d: return expect(c, 'o', State::do_);
+		case State::do_:
+			if (c == '(') {
+				state = State::do_open;
+				return;
+			}
+			return expect(c, 'n', State::don);
+		case State::do_open:
+			if (c == ')') {
+				enabled = true;
+				state = State::start;
+				return;
+			}
+			break;
+		case State::don: return expect(c, '\'', State::don_);
+		case State::don_: return expect(c, 't', State::don_t);
+		case State::don_t: return expect(c, '(', State::don_t_open);
+		case State::don_t_open:
+			if (c == ')') {
+				enabled = false;
+				state = State::start;
+				return;
+			}
+			break;
+		case State::start:
+			break;
+		}
+
+		// No instruction continues with c, but it may start the next one
+		state = c == 'm' ? State::m : c == 'd' ? State::d : State::start;
+	}
+
+	void expect(char c, char expected, State next)
+	{
+		if (c == expected) {
+			state = next;
+		}
+		else {
+			state = State::start;
+			step(c);
+		}
+	}
+
+	State state = State::start;
+	int num_digits = 0;
+	long first = 0;
+	long second = 0;
+	bool enabled = true;
+	bool at_line_start = true;
+	bool pending_cr = false;
+	bool ended = false;
+	std::size_t size = 0;
+	long total = 0;
+};
+
+// The memory is scanned straight from the input text by solve
+aoc::Unparsed parse(aoc::Scanner &in)
+{
+	return {in.remaining()};
 }
+
+Result solve(aoc::Unparsed input)
+{
+	MemoryScanner scanner;
+
+	scanner.scan(input.text);
+
+	return scanner.result();
+}
+
+// Scan the input a block at a time. The scanner carries partly read
+// instructions and the enabled flag over from one block to the next, so
+// memory use does not grow with the input.
+Result stream(std::FILE *in)
+{
+	MemoryScanner scanner;
+
+	aoc::read_blocks(in, std::size_t{64} * 1024, [&](std::string_view block) {
+		return scanner.scan(block);
+	});
+
+	return scanner.result();
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "memory size is '{}'", result.memory_size);
+	std::println(out, "total is {}", result.total);
+}
+
+} // namespace
+
+AOC_STREAMING_SOLVER(parse, solve, print, stream)
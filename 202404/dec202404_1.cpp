@@ -3,61 +3,78 @@
 //
 
 #include <array>
-#include <iostream>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
 #include <print>
-#include <string>
 #include <vector>
 
-auto read_and_pad_map()
+#include "bit_grid.h"
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+// Bit grids of the letters X, M, A and S
+using Planes = std::vector<aoc::BitGrid>;
+
+// Number of times the letters given by word, as indices into planes, appear
+// starting at any cell and going in direction (dx, dy), where dy >= 0. The
+// word is matched at 64 cells at a time by combining the shifted words of
+// the rows it covers.
+long count_word(const Planes &planes, const std::array<int, 4> &word, int dx, int dy)
 {
-	std::vector<std::string> map;
+	const auto &first = planes[word[0]];
 
-	// Pad map with '.'
-	for (std::string line; std::getline(std::cin, line); ) {
-		map.push_back("." + line + ".");
-	}
+	long count = 0;
+
+	for (int y = 0; y + 3 * dy < first.height(); ++y) {
+		for (std::size_t w = 0; w < first.words_per_row(); ++w) {
+			auto found = first.word(y, w, 0);
 
-	map.insert(map.begin(), std::string(map.front().size(), '.'));
-	map.push_back(std::string(map.front().size(), '.'));
+			for (int k = 1; k < 4 && found != 0; ++k) {
+				found &= planes[word[k]].word(y + k * dy, w, k * dx);
+			}
 
-	return map;
+			count += std::popcount(found);
+		}
+	}
+
+	return count;
 }
 
-int count_xmas(const auto &map, int x, int y)
+Planes parse(aoc::Scanner &in)
 {
-	constexpr std::array<std::array<int, 2>, 8> directions = {{
-		{ 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 },
-		{ 0, -1 }, { -1, -1 }, { -1, 0 }, { -1, 1 }
-	}};
+	return aoc::letter_planes(in.lines(), "XMAS");
+}
 
-	if (map[y][x] != 'X') {
+long solve(const Planes &planes)
+{
+	if (planes[0].height() == 0) {
 		return 0;
 	}
 
-	int num_found = 0;
+	// Reading XMAS in one of the other four directions is reading SAMX in
+	// the opposite one
+	constexpr std::array<std::array<int, 2>, 4> directions = {{
+		{ 1, 0 }, { 0, 1 }, { 1, 1 }, { -1, 1 }
+	}};
+
+	long total_xmas = 0;
 
 	for (auto [dx, dy] : directions) {
-		if (map[y + 1*dy][x + 1*dx] == 'M'
-		 && map[y + 2*dy][x + 2*dx] == 'A'
-		 && map[y + 3*dy][x + 3*dx] == 'S') {
-			++num_found;
-		}
+		total_xmas += count_word(planes, {0, 1, 2, 3}, dx, dy);
+		total_xmas += count_word(planes, {3, 2, 1, 0}, dx, dy);
 	}
 
-	return num_found;
+	return total_xmas;
 }
 
-int main()
+void print(std::FILE *out, long total_xmas)
 {
-	auto map = read_and_pad_map();
-
-	int total_xmas = 0;
+	std::println(out, "found {} XMAS", total_xmas);
+}
 
-	for (int y = 1; y < std::ssize(map); ++y) {
-		for (int x = 1; x < std::ssize(map.front()); ++x) {
-			total_xmas += count_xmas(map, x, y);
-		}
-	}
+} // namespace
 
-	std::println("found {} XMAS", total_xmas);
-}
+AOC_SOLVER(parse, solve, print)
@@ -2,52 +2,62 @@
 // Advent of Code 2024, day 4, part two
 //
 
-#include <iostream>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
 #include <print>
-#include <string>
 #include <vector>
 
-auto read_and_pad_map()
-{
-	std::vector<std::string> map;
+#include "bit_grid.h"
+#include "input.h"
+#include "solver.h"
 
-	// Pad map with '.'
-	for (std::string line; std::getline(std::cin, line); ) {
-		map.push_back("." + line + ".");
-	}
+namespace {
 
-	map.insert(map.begin(), std::string(map.front().size(), '.'));
-	map.push_back(std::string(map.front().size(), '.'));
+// Bit grids of the letters M, A and S
+using Planes = std::vector<aoc::BitGrid>;
 
-	return map;
+Planes parse(aoc::Scanner &in)
+{
+	return aoc::letter_planes(in.lines(), "MAS");
 }
 
-int count_x_mas(const auto &map, int x, int y)
+// Count the A cells with MAS or SAM on both diagonals through them, for 64
+// cells of a row at a time
+long solve(const Planes &planes)
 {
-	if (map[y][x] != 'A') {
-		return 0;
-	}
+	const auto &m = planes[0];
+	const auto &a = planes[1];
+	const auto &s = planes[2];
 
-	auto nw = map[y - 1][x - 1];
-	auto ne = map[y - 1][x + 1];
-	auto se = map[y + 1][x + 1];
-	auto sw = map[y + 1][x - 1];
+	long total_xmas = 0;
 
-	return ((nw == 'M' && se == 'S') || (nw == 'S' && se == 'M'))
-	    && ((ne == 'M' && sw == 'S') || (ne == 'S' && sw == 'M'));
-}
+	for (int y = 1; y + 1 < a.height(); ++y) {
+		for (std::size_t w = 0; w < a.words_per_row(); ++w) {
+			auto found = a.word(y, w, 0);
 
-int main()
-{
-	auto map = read_and_pad_map();
+			if (found == 0) {
+				continue;
+			}
 
-	int total_xmas = 0;
+			auto falling = (m.word(y - 1, w, -1) & s.word(y + 1, w, 1))
+			             | (s.word(y - 1, w, -1) & m.word(y + 1, w, 1));
 
-	for (int y = 1; y < std::ssize(map); ++y) {
-		for (int x = 1; x < std::ssize(map.front()); ++x) {
-			total_xmas += count_x_mas(map, x, y);
+			auto rising = (m.word(y + 1, w, -1) & s.word(y - 1, w, 1))
+			            | (s.word(y + 1, w, -1) & m.word(y - 1, w, 1));
+
+			total_xmas += std::popcount(found & falling & rising);
 		}
 	}
 
-	std::println("found {} X-MAS", total_xmas);
+	return total_xmas;
+}
+
+void print(std::FILE *out, long total_xmas)
+{
+	std::println(out, "found {} X-MAS", total_xmas);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
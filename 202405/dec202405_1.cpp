@@ -3,70 +3,158 @@
 //
 
 #include <array>
-#include <iostream>
+#include <bitset>
+#include <cstddef>
+#include <cstdio>
+#include <format>
 #include <print>
-#include <ranges>
-#include <sstream>
-#include <string>
-#include <utility>
+#include <span>
+#include <string_view>
 #include <vector>
 
-auto read_rules()
-{
-	std::vector<std::pair<int, int>> rules;
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+// Page numbers are two digits
+constexpr std::size_t num_pages = 100;
+
+using PageSet = std::bitset<num_pages>;
+
+// Ordering rules, which may be added while updates are being checked. The
+// rules are a bit matrix, where the row of a page holds the pages that have
+// to come after it. Adding a rule sets one bit, and an update is checked
+// with one row lookup per page, so the time taken grows with the length of
+// the update, not the number of rules.
+class RuleIndex {
+public:
+	void add_rule(int before, int after)
+	{
+		successors[before].set(after);
+	}
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::istringstream is(line);
+	// Whether no page comes after a page it has to be before
+	bool is_ordered(std::span<const int> pages) const
+	{
+		PageSet seen;
 
-		int before = 0;
-		int after = 0;
-		char ch = ' ';
+		for (auto page : pages) {
+			if ((successors[page] & seen).any()) {
+				return false;
+			}
 
-		if (is >> before >> ch >> after) {
-			rules.emplace_back(before, after);
+			seen.set(page);
 		}
+
+		return true;
 	}
 
-	return rules;
-}
+private:
+	std::array<PageSet, num_pages> successors;
+};
 
-bool pages_match_rules(const auto &pages, const auto &rules)
-{
-	std::array<int, 100> page_index = {};
+struct Result {
+	long median_sum = 0;
+	long num_updates = 0;
+
+	// Updates per second are shown with --time
+	long items() const { return num_updates; }
+};
+
+// Rules and updates are handled a line at a time in the order they come,
+// so an update is checked against the rules given before it
+class Manual {
+public:
+	void add_line(std::string_view line)
+	{
+		if (line.contains('|')) {
+			aoc::Scanner is(line);
+
+			int before = 0;
+			int after = 0;
+
+			if (is.next(before, after)) {
+				rules.add_rule(check_page(before), check_page(after));
+			}
+
+			return;
+		}
+
+		pages.clear();
+
+		aoc::Scanner is(line);
+
+		for (int page = 0; is.next(page); ) {
+			pages.push_back(check_page(page));
+		}
+
+		if (pages.empty()) {
+			return;
+		}
 
-	page_index.fill(-1);
+		++result.num_updates;
 
-	for (int i = 0; i < std::ssize(pages); ++i) {
-		page_index[pages[i]] = i;
+		if (rules.is_ordered(pages)) {
+			result.median_sum += pages[pages.size() / 2];
+		}
 	}
 
-	for (auto [before, after] : rules) {
-		if (page_index[before] != -1 && page_index[after] != -1
-		 && page_index[before] > page_index[after]) {
-			return false;
+	const Result &totals() const { return result; }
+
+private:
+	// The rule index only holds the pages 0 to 99
+	static int check_page(int page)
+	{
+		if (page < 0 || page >= static_cast<int>(num_pages)) {
+			throw aoc::InputError(std::format("bad page number {}", page));
 		}
+
+		return page;
 	}
 
-	return true;
-}
+	RuleIndex rules;
+	std::vector<int> pages;
+	Result result;
+};
 
-int main()
+// The lines are handled straight from the input text by solve
+aoc::Unparsed parse(aoc::Scanner &in)
 {
-	auto rules = read_rules();
+	return {in.remaining()};
+}
 
-	long median_sum = 0;
+Result solve(aoc::Unparsed input)
+{
+	Manual manual;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		auto pages = line | std::views::split(',') | std::views::transform(
-			[](const auto part) {
-				return std::stoi(std::string(part.data(), part.size()));
-			}
-		) | std::ranges::to<std::vector>();
+	aoc::Scanner in(input.text);
 
-		if (pages_match_rules(pages, rules)) {
-			median_sum += pages[pages.size() / 2];
-		}
+	for (std::string_view line; in.getline(line); ) {
+		manual.add_line(line);
 	}
 
-	std::println("median sum is {}", median_sum);
+	return manual.totals();
 }
+
+// Handle the lines as they are read, for input that keeps coming
+Result stream(std::FILE *in)
+{
+	Manual manual;
+
+	aoc::read_lines(in, [&](std::string_view line) {
+		manual.add_line(line);
+		return true;
+	});
+
+	return manual.totals();
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "median sum is {}", result.median_sum);
+}
+
+} // namespace
+
+AOC_STREAMING_SOLVER(parse, solve, print, stream)
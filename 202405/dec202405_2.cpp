@@ -2,99 +2,245 @@
 // Advent of Code 2024, day 5, part two
 //
 
+#include <algorithm>
 #include <array>
-#include <iostream>
+#include <bitset>
+#include <cstddef>
+#include <cstdio>
+#include <format>
+#include <iterator>
 #include <print>
-#include <ranges>
-#include <sstream>
-#include <string>
+#include <span>
+#include <string_view>
 #include <utility>
 #include <vector>
 
-auto read_rules()
-{
-	std::vector<std::pair<int, int>> rules;
+#include "input.h"
+#include "solver.h"
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::istringstream is(line);
+namespace {
 
-		int before = 0;
-		int after = 0;
-		char ch = ' ';
+// Page numbers are two digits
+constexpr std::size_t num_pages = 100;
 
-		if (is >> before >> ch >> after) {
-			rules.emplace_back(before, after);
-		}
+using PageSet = std::bitset<num_pages>;
+
+// Ordering rules, which may be added while updates are being checked. The
+// rules are a bit matrix, where the row of a page holds the pages that have
+// to come after it, along with its transpose. Adding a rule sets two bits,
+// and an update is checked or reordered with row lookups per page, so the
+// time taken grows with the length of the update, not the number of rules.
+class RuleIndex {
+public:
+	void add_rule(int before, int after)
+	{
+		successors[before].set(after);
+		predecessors[after].set(before);
 	}
 
-	return rules;
-}
+	// Whether no page comes after a page it has to be before
+	bool is_ordered(std::span<const int> pages) const
+	{
+		PageSet seen;
 
-bool pages_match_rules(const auto &pages, const auto &rules)
-{
-	std::array<int, 100> page_index = {};
+		for (auto page : pages) {
+			if ((successors[page] & seen).any()) {
+				return false;
+			}
 
-	page_index.fill(-1);
+			seen.set(page);
+		}
 
-	for (int i = 0; i < std::ssize(pages); ++i) {
-		page_index[pages[i]] = i;
+		return true;
 	}
 
-	for (auto [before, after] : rules) {
-		if (page_index[before] != -1 && page_index[after] != -1
-		 && page_index[before] > page_index[after]) {
-			return false;
+	// Put pages in an order that matches the rules. If no page is repeated
+	// and the rules order every pair of pages in the update, the position of
+	// a page is the number of pages that have to come before it, and the
+	// pages are placed directly. Otherwise they are sorted topologically,
+	// keeping the given order where the rules allow it, and a repeated page
+	// stays repeated.
+	void reorder(std::vector<int> &pages) const
+	{
+		const auto num_pages_in_update = pages.size();
+
+		PageSet in_update;
+
+		bool repeated = false;
+
+		for (auto page : pages) {
+			repeated = repeated || in_update.test(page);
+			in_update.set(page);
 		}
-	}
 
-	return true;
-}
+		std::vector<int> sorted(num_pages_in_update, -1);
 
-void fix_page_order(auto &pages, const auto &rules)
-{
-	// Assume we can fix the page order by swapping any two pages
-	// that break a rule
-	for (bool change = true; change; ) {
-		change = false;
+		bool total_order = !repeated;
 
-		std::array<int, 100> page_index = {};
+		for (auto page : pages) {
+			if (!total_order) {
+				break;
+			}
 
-		page_index.fill(-1);
+			auto num_after = (successors[page] & in_update).count();
 
-		for (int i = 0; i < std::ssize(pages); ++i) {
-			page_index[pages[i]] = i;
+			auto &slot = sorted[num_pages_in_update - 1 - std::min(num_after, num_pages_in_update - 1)];
+
+			if (slot != -1) {
+				total_order = false;
+			}
+
+			slot = page;
+		}
+
+		if (total_order) {
+			pages = std::move(sorted);
+			return;
+		}
+
+		// Distinct pages in the order they first appear, and how many times
+		std::array<int, num_pages> copies = {};
+		std::vector<int> distinct;
+
+		for (auto page : pages) {
+			if (copies[page]++ == 0) {
+				distinct.push_back(page);
+			}
 		}
 
-		for (auto [before, after] : rules) {
-			if (page_index[before] != -1 && page_index[after] != -1
-			 && page_index[before] > page_index[after]) {
-				std::swap(pages[page_index[before]], pages[page_index[after]]);
-				change = true;
+		sorted.clear();
+
+		PageSet remaining = in_update;
+
+		// Each step scans the d distinct pages with one row lookup each, so
+		// this is O(n + d^2) for an update of n pages, where d <= 100
+		while (remaining.any()) {
+			// Next page that no page left to place has to come before
+			auto it = std::ranges::find_if(distinct, [&](int page) {
+				return remaining.test(page) && (predecessors[page] & remaining).none();
+			});
+
+			// The rules form a cycle, keep the rest as it is
+			if (it == distinct.end()) {
+				std::ranges::copy_if(pages, std::back_inserter(sorted), [&](int page) { return remaining.test(page); });
 				break;
 			}
+
+			sorted.insert(sorted.end(), copies[*it], *it);
+			remaining.reset(*it);
 		}
+
+		pages = std::move(sorted);
 	}
-}
 
-int main()
-{
-	auto rules = read_rules();
+private:
+	std::array<PageSet, num_pages> successors;
+	std::array<PageSet, num_pages> predecessors;
+};
 
+struct Result {
 	long median_sum = 0;
-
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		auto pages = line | std::views::split(',') | std::views::transform(
-			[](const auto part) {
-				return std::stoi(std::string(part.data(), part.size()));
+	long num_updates = 0;
+
+	// Updates per second are shown with --time
+	long items() const { return num_updates; }
+};
+
+// Rules and updates are handled a line at a time in the order they come,
+// so an update is checked against the rules given before it
+class Manual {
+public:
+	void add_line(std::string_view line)
+	{
+		if (line.contains('|')) {
+			aoc::Scanner is(line);
+
+			int before = 0;
+			int after = 0;
+
+			if (is.next(before, after)) {
+				rules.add_rule(check_page(before), check_page(after));
 			}
-		) | std::ranges::to<std::vector>();
 
-		if (!pages_match_rules(pages, rules)) {
-			fix_page_order(pages, rules);
+			return;
+		}
 
-			median_sum += pages[pages.size() / 2];
+		pages.clear();
+
+		aoc::Scanner is(line);
+
+		for (int page = 0; is.next(page); ) {
+			pages.push_back(check_page(page));
+		}
+
+		if (pages.empty()) {
+			return;
+		}
+
+		++result.num_updates;
+
+		if (!rules.is_ordered(pages)) {
+			rules.reorder(pages);
+
+			result.median_sum += pages[pages.size() / 2];
 		}
 	}
 
-	std::println("median sum is {}", median_sum);
+	const Result &totals() const { return result; }
+
+private:
+	// The rule index only holds the pages 0 to 99
+	static int check_page(int page)
+	{
+		if (page < 0 || page >= static_cast<int>(num_pages)) {
+			throw aoc::InputError(std::format("bad page number {}", page));
+		}
+
+		return page;
+	}
+
+	RuleIndex rules;
+	std::vector<int> pages;
+	Result result;
+};
+
+// The lines are handled straight from the input text by solve
+aoc::Unparsed parse(aoc::Scanner &in)
+{
+	return {in.remaining()};
+}
+
+Result solve(aoc::Unparsed input)
+{
+	Manual manual;
+
+	aoc::Scanner in(input.text);
+
+	for (std::string_view line; in.getline(line); ) {
+		manual.add_line(line);
+	}
+
+	return manual.totals();
+}
+
+// Handle the lines as they are read, for input that keeps coming
+Result stream(std::FILE *in)
+{
+	Manual manual;
+
+	aoc::read_lines(in, [&](std::string_view line) {
+		manual.add_line(line);
+		return true;
+	});
+
+	return manual.totals();
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "median sum is {}", result.median_sum);
 }
+
+} // namespace
+
+AOC_STREAMING_SOLVER(parse, solve, print, stream)
@@ -3,47 +3,31 @@
 //
 
 #include <algorithm>
-#include <functional>
-#include <iostream>
+#include <cstdio>
 #include <print>
-#include <ranges>
-#include <string>
 #include <utility>
-#include <vector>
 
-auto read_and_pad_map()
-{
-	std::vector<std::string> map;
-
-	// Pad map with 'E'
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back("E" + line + "E");
-	}
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
 
-	map.insert(map.begin(), std::string(map.front().size(), 'E'));
-	map.push_back(std::string(map.front().size(), 'E'));
+namespace {
 
-	return map;
+aoc::Grid<char> parse(aoc::Scanner &in)
+{
+	// Pad map with 'E'
+	return aoc::read_grid(in, 1, 'E');
 }
 
-int main()
+long solve(aoc::Grid<char> map)
 {
-	auto map = read_and_pad_map();
-
-	auto [start_x, start_y] = [&map]() -> std::pair<int, int> {
-		for (const auto &[y, str] : std::views::enumerate(map)) {
-			if (auto x = str.find('^'); x != std::string::npos) {
-				return {x, y};
-			}
-		}
-		return {-1, -1};
-	}();
+	auto [start_x, start_y] = map.coords(map.find('^'));
 
 	// Mark positions visited by the guard with X
 	for (int x = start_x, y = start_y, dx = 0, dy = -1; ;) {
-		map[y][x] = 'X';
+		map(x, y) = 'X';
 
-		while (map[y + dy][x + dx] == '#') {
+		while (map(x + dx, y + dy) == '#') {
 			// Rotate direction 90 degrees right
 			dy = std::exchange(dx, -dy);
 		}
@@ -51,13 +35,20 @@ int main()
 		x += dx;
 		y += dy;
 
-		if (map[y][x] == 'E') {
+		if (map(x, y) == 'E') {
 			break;
 		}
 	}
 
 	// Count number of Xs
-	auto positions_visited = std::ranges::count(map | std::views::join, 'X');
+	return std::ranges::count(map, 'X');
+}
 
-	std::println("{} positions visited", positions_visited);
+void print(std::FILE *out, long positions_visited)
+{
+	std::println(out, "{} positions visited", positions_visited);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -2,122 +2,276 @@
 // Advent of Code 2024, day 6, part two
 //
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <functional>
-#include <iostream>
 #include <print>
-#include <ranges>
-#include <string>
-#include <unordered_set>
-#include <utility>
 #include <vector>
 
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
+#include "coord_set.h"
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
+#include "thread_pool.h"
+
+namespace {
+
+// Up, right, down, left, so turning right is going to the next direction
+constexpr std::array<std::array<int, 2>, 4> guard_directions = {{
+	{ 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 }
+}};
+
+// For each cell and direction, the number of steps the guard can walk
+// before the next cell is an obstacle or off the map. Walking a path then
+// takes one lookup per turn instead of one per step.
+//
+// Distances are capped at max_jump to keep the table at four bytes per
+// cell, longer runs are walked in several jumps.
+//
+// The obstacles are also numbered, so state kept per walk can be sized by
+// the number of obstacles instead of the number of cells.
+class JumpTable {
+public:
+	static constexpr int max_jump = 255;
+
+	explicit JumpTable(const aoc::Grid<char> &map)
+		: offsets(map.offsets(guard_directions)), steps(map.size()), obstacle_ids(map.size())
 	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
+		for (std::size_t idx = 0; idx < map.size(); ++idx) {
+			if (map[idx] == '#') {
+				obstacle_ids[idx] = num_obstacles_++;
+			}
+		}
 
-auto read_and_pad_map()
-{
-	std::vector<std::string> map;
+		for (int dir = 0; dir < 4; ++dir) {
+			auto [dx, dy] = guard_directions[dir];
 
-	// Pad map with 'E'
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back("E" + line + "E");
+			// Visit cells so the one ahead is always done first
+			for (int i = 0; i < map.height(); ++i) {
+				int y = dy > 0 ? map.height() - 1 - i : i;
+
+				for (int j = 0; j < map.width(); ++j) {
+					int x = dx > 0 ? map.width() - 1 - j : j;
+
+					auto idx = map.index(x, y);
+					auto ahead = idx + offsets[dir];
+
+					if (map[ahead] == '#' || map[ahead] == 'E') {
+						steps[idx][dir] = 0;
+					}
+					else {
+						steps[idx][dir] = static_cast<std::uint8_t>(std::min(steps[ahead][dir] + 1, max_jump));
+					}
+				}
+			}
+		}
 	}
 
-	map.insert(map.begin(), std::string(map.front().size(), 'E'));
-	map.push_back(std::string(map.front().size(), 'E'));
+	std::ptrdiff_t offset(int dir) const { return offsets[dir]; }
 
-	return map;
-}
+	std::uint32_t num_obstacles() const { return num_obstacles_; }
 
-bool guard_loops(const auto &map, int start_x, int start_y)
-{
-	int steps = 0;
+	// Number of the obstacle at idx
+	std::uint32_t obstacle_id(std::ptrdiff_t idx) const { return obstacle_ids[idx]; }
 
-	for (int x = start_x, y = start_y, dx = 0, dy = -1; ;) {
-		while (map[y + dy][x + dx] == '#') {
-			// Rotate direction 90 degrees right
-			dy = std::exchange(dx, -dy);
+	int jump(std::ptrdiff_t idx, int dir) const { return steps[idx][dir]; }
+
+	// Like jump(), but with an extra obstacle at index obstacle
+	int jump(std::ptrdiff_t idx, int dir, std::ptrdiff_t obstacle) const
+	{
+		int num_steps = steps[idx][dir];
+
+		// The obstacle is in the way if it is at most one step past
+		// where the guard would stop. Moving along a row, that is
+		// never past the padding at the end of it.
+		auto delta = obstacle - idx;
+
+		if (delta % offsets[dir] == 0) {
+			auto ahead = delta / offsets[dir];
+
+			if (ahead > 0 && ahead <= num_steps + 1) {
+				return static_cast<int>(ahead) - 1;
+			}
 		}
 
-		x += dx;
-		y += dy;
+		return num_steps;
+	}
 
-		if (map[y][x] == 'E') {
-			break;
+private:
+	std::array<std::ptrdiff_t, 4> offsets;
+	std::vector<std::array<std::uint8_t, 4>> steps;
+	std::vector<std::uint32_t> obstacle_ids;
+	std::uint32_t num_obstacles_ = 0;
+};
+
+// Directions the guard faced when turning at each obstacle during the
+// current walk, as a four bit mask below the number of the walk. Starting a
+// new walk bumps the number, which makes all older masks read as empty
+// without clearing. Each thread needs its own.
+class TurnLog {
+public:
+	explicit TurnLog(std::size_t num_obstacles) : cells(num_obstacles) {}
+
+	void next_walk()
+	{
+		if (++walk == max_walk) {
+			std::ranges::fill(cells, 0);
+			walk = 1;
 		}
+	}
+
+	// Record turning at obstacle id while facing dir, returns false if the
+	// guard already did that during this walk
+	bool insert(std::uint32_t id, int dir)
+	{
+		auto &cell = cells[id];
+		std::uint32_t mask = (cell >> 4) == walk ? cell & 0x0F : 0;
+		std::uint32_t bit = 1U << dir;
 
-		++steps;
-
-		// If guard has walked 10.000 steps, assume he is looping
-		//
-		// I initially wrote this as a quick hack before writing
-		// a version that stores visited positions and directions
-		// in a set to know exactly when the guard starts looping.
-		// However it turned out for this problem size it was an
-		// order of magnitude faster to just check for a large
-		// number of steps.
-		if (steps == 10'000) {
-			return true;
+		if (mask & bit) {
+			return false;
 		}
+
+		cell = (walk << 4) | mask | bit;
+
+		return true;
 	}
 
-	return false;
-}
+private:
+	static constexpr std::uint32_t max_walk = 1U << 28;
+
+	std::vector<std::uint32_t> cells;
+	std::uint32_t walk = 0;
+};
 
-int main()
+// Guard state just before first stepping onto a cell, the cell is where an
+// extra obstacle is tried
+struct Candidate {
+	std::ptrdiff_t obstacle;
+	std::ptrdiff_t from;
+	int dir;
+};
+
+// The guard is in a loop exactly when turning at the same obstacle in the
+// same direction a second time, so only turns need recording. The extra
+// obstacle is numbered after those of the map.
+//
+// The path up to the first visit of the candidate cell is the same with or
+// without the obstacle, so the walk starts from there.
+bool guard_loops(const aoc::Grid<char> &map, const JumpTable &jumps, TurnLog &turns,
+                 const Candidate &candidate)
 {
-	auto map = read_and_pad_map();
+	const auto obstacle = candidate.obstacle;
+
+	turns.next_walk();
+
+	int dir = candidate.dir;
 
-	auto [start_x, start_y] = [&map]() -> std::pair<int, int> {
-		for (const auto &[y, str] : std::views::enumerate(map)) {
-			if (auto x = str.find('^'); x != std::string::npos) {
-				return {x, y};
+	for (std::ptrdiff_t idx = candidate.from; ;) {
+		idx += jumps.jump(idx, dir, obstacle) * jumps.offset(dir);
+
+		auto ahead = idx + jumps.offset(dir);
+
+		if (ahead == obstacle || map[ahead] == '#') {
+			auto id = ahead == obstacle ? jumps.num_obstacles() : jumps.obstacle_id(ahead);
+
+			if (!turns.insert(id, dir)) {
+				return true;
 			}
+
+			// Rotate direction 90 degrees right
+			dir = (dir + 1) % 4;
 		}
-		return {-1, -1};
-	}();
+		else if (map[ahead] == 'E') {
+			return false;
+		}
+	}
+}
+
+aoc::Grid<char> parse(aoc::Scanner &in)
+{
+	// Pad map with 'E'
+	return aoc::read_grid(in, 1, 'E');
+}
+
+// Maps with at least this many candidates are checked on all cores
+constexpr std::size_t min_parallel_candidates = 4096;
+
+int solve(aoc::Grid<char> map)
+{
+	const JumpTable jumps(map);
 
-	std::unordered_set<std::pair<int, int>, PairHash> visited;
+	const auto start = map.find('^');
 
-	// Get positions visited by the guard
-	for (int x = start_x, y = start_y, dx = 0, dy = -1; ;) {
-		visited.emplace(x, y);
+	aoc::CoordSet visited(map);
 
-		while (map[y + dy][x + dx] == '#') {
+	visited.insert(map.coords(start));
+
+	std::vector<Candidate> candidates;
+
+	int dir = 0;
+
+	// Walk the guard, noting the state before each newly visited cell
+	for (std::ptrdiff_t idx = start; ;) {
+		auto ahead = idx + jumps.offset(dir);
+
+		if (map[ahead] == '#') {
 			// Rotate direction 90 degrees right
-			dy = std::exchange(dx, -dy);
+			dir = (dir + 1) % 4;
+			continue;
 		}
 
-		x += dx;
-		y += dy;
-
-		if (map[y][x] == 'E') {
+		if (map[ahead] == 'E') {
 			break;
 		}
-	}
 
-	visited.erase({start_x, start_y});
+		if (auto pos = map.coords(ahead); !visited.contains(pos)) {
+			visited.insert(pos);
+			candidates.push_back({ahead, idx, dir});
+		}
 
-	int num_loop_positions = 0;
+		idx = ahead;
+	}
 
-	// Try putting an obstacle in each position the guard visited
-	for (auto [x, y] : visited) {
-		map[y][x] = '#';
+	auto count_loops = [&](std::size_t begin, std::size_t end) {
+		TurnLog turns(jumps.num_obstacles() + 1);
 
-		if (guard_loops(map, start_x, start_y)) {
-			++num_loop_positions;
+		int count = 0;
+
+		for (std::size_t i = begin; i < end; ++i) {
+			count += guard_loops(map, jumps, turns, candidates[i]);
 		}
 
-		map[y][x] = '.';
+		return count;
+	};
+
+	if (!aoc::use_parallel(candidates.size(), min_parallel_candidates)) {
+		return count_loops(0, candidates.size());
 	}
 
-	std::println("{} positions", num_loop_positions);
+	auto &pool = aoc::shared_pool();
+
+	// Loops take longer to find than exits, so use more chunks than
+	// threads to even out the work
+	const auto num_chunks = 4 * pool.size();
+
+	std::vector<int> counts(num_chunks);
+
+	aoc::parallel_for(pool, candidates.size(), num_chunks, [&](auto chunk, auto begin, auto end) {
+		counts[chunk] = count_loops(begin, end);
+	});
+
+	return std::ranges::fold_left(counts, 0, std::plus{});
 }
+
+void print(std::FILE *out, int num_loop_positions)
+{
+	std::println(out, "{} positions", num_loop_positions);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -3,80 +3,78 @@
 //
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <functional>
-#include <iostream>
-#include <iterator>
-#include <limits>
 #include <print>
 #include <ranges>
-#include <sstream>
-#include <string>
+#include <span>
+#include <string_view>
 #include <utility>
 #include <vector>
 
-auto read_equations()
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+using Equation = std::pair<std::uint64_t, std::vector<std::uint32_t>>;
+
+std::vector<Equation> parse(aoc::Scanner &in)
 {
-	std::vector<std::pair<std::uint64_t, std::vector<std::uint32_t>>> equations;
+	std::vector<Equation> equations;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::istringstream is(line);
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
+		aoc::Scanner is(line);
 
 		std::uint64_t test_value = 0;
 
-		is >> test_value;
+		is.next(test_value);
 
-		is.ignore();
+		auto numbers = aoc::numbers<std::uint32_t>(is.remaining());
 
-		std::vector<std::uint32_t> numbers(std::istream_iterator<std::uint32_t>{is},
-		                                   std::istream_iterator<std::uint32_t>{});
-
-		equations.emplace_back(test_value, numbers);
+		equations.emplace_back(test_value, std::move(numbers));
 	}
 
 	return equations;
 }
 
-std::uint64_t evaluate(const auto &equation, std::uint64_t bits)
+// Check if numbers can be combined into target by working back from the
+// last number, undoing each operator that could have produced target. A
+// product must divide target, which rules out most branches early.
+bool can_make(std::uint64_t target, std::span<const std::uint32_t> numbers)
 {
-	std::uint64_t result = equation.second.front();
+	const std::uint64_t last = numbers.back();
 
-	for (const auto &[num, value] : std::views::enumerate(equation.second) | std::views::drop(1)) {
-		if (bits & (std::uint64_t{1} << (num - 1))) {
-			if (result > std::numeric_limits<std::uint64_t>::max() / value) {
-				return 0;
-			}
+	if (numbers.size() == 1) {
+		return target == last;
+	}
 
-			result *= value;
-		}
-		else {
-			if (result > std::numeric_limits<std::uint64_t>::max() - value) {
-				return 0;
-			}
+	auto rest = numbers.first(numbers.size() - 1);
 
-			result += value;
+	// Anything times zero is zero
+	if (last == 0) {
+		if (target == 0) {
+			return true;
 		}
 	}
+	else if (target % last == 0 && can_make(target / last, rest)) {
+		return true;
+	}
 
-	return result;
+	return target >= last && can_make(target - last, rest);
 }
 
-int main()
-{
-	auto equations = read_equations();
-
-	std::println("read {} equations", equations.size());
+struct Result {
+	std::size_t num_equations = 0;
+	std::uint64_t calibration_result = 0;
+};
 
+Result solve(const std::vector<Equation> &equations)
+{
 	auto can_be_true = [](const auto &equation) {
-		const std::uint64_t limit = std::uint64_t{1} << equation.second.size();
-
-		for (std::uint64_t bits = 0; bits < limit; ++bits) {
-			if (evaluate(equation, bits) == equation.first) {
-				return true;
-			}
-		}
-
-		return false;
+		return !equation.second.empty() && can_make(equation.first, equation.second);
 	};
 
 	auto calibration_result = std::ranges::fold_left(
@@ -85,5 +83,15 @@ int main()
 		std::plus{}
 	);
 
-	std::println("total calibration result is {}", calibration_result);
+	return {equations.size(), calibration_result};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "read {} equations", result.num_equations);
+	std::println(out, "total calibration result is {}", result.calibration_result);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -3,125 +3,101 @@
 //
 
 #include <algorithm>
-#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <functional>
-#include <iostream>
-#include <iterator>
-#include <limits>
 #include <print>
 #include <ranges>
-#include <sstream>
-#include <string>
+#include <span>
+#include <string_view>
 #include <utility>
 #include <vector>
 
-auto read_equations()
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+using Equation = std::pair<std::uint64_t, std::vector<std::uint32_t>>;
+
+std::vector<Equation> parse(aoc::Scanner &in)
 {
-	std::vector<std::pair<std::uint64_t, std::vector<std::uint32_t>>> equations;
+	std::vector<Equation> equations;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::istringstream is(line);
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
+		aoc::Scanner is(line);
 
 		std::uint64_t test_value = 0;
 
-		is >> test_value;
-
-		is.ignore();
+		is.next(test_value);
 
-		std::vector<std::uint32_t> numbers(std::istream_iterator<std::uint32_t>{is},
-		                                   std::istream_iterator<std::uint32_t>{});
+		auto numbers = aoc::numbers<std::uint32_t>(is.remaining());
 
-		equations.emplace_back(test_value, numbers);
+		equations.emplace_back(test_value, std::move(numbers));
 	}
 
 	return equations;
 }
 
-constexpr std::uint64_t concat(std::uint64_t a, std::uint64_t b)
+// Smallest power of ten above value, so a || value is a * factor + value
+constexpr std::uint64_t digit_factor(std::uint32_t value)
 {
 	std::uint64_t factor = 10;
 
-	while (factor <= b) {
+	while (factor <= value) {
 		factor *= 10;
 	}
 
-	if (a > std::numeric_limits<std::uint64_t>::max() / factor) {
-		return 0;
-	}
-
-	return a * factor + b;
+	return factor;
 }
 
-static_assert(concat(123, 456) == 123456);
-static_assert(concat(0, 456) == 456);
-static_assert(concat(456, 0) == 4560);
-
-struct Operators {
-	void next() {
-		for (auto &val : state) {
-			++val;
-
-			if (val != 3) {
-				break;
-			}
+static_assert(digit_factor(0) == 10);
+static_assert(digit_factor(456) == 1000);
+static_assert(digit_factor(1000) == 10000);
 
-			val = 0;
-		}
-	}
-
-	std::array<std::uint8_t, 64> state = {};
-};
-
-std::uint64_t evaluate(const auto &equation, const Operators &ops, std::uint64_t target)
+// Check if numbers can be combined into target by working back from the
+// last number, undoing each operator that could have produced target. A
+// product must divide target and a concatenation must end with the
+// digits of the number, which rules out most branches early.
+bool can_make(std::uint64_t target, std::span<const std::uint32_t> numbers)
 {
-	std::uint64_t result = equation.second.front();
-
-	for (const auto &[num, value] : std::views::enumerate(equation.second) | std::views::drop(1)) {
-		if (ops.state[num - 1] == 0) {
-			if (result > std::numeric_limits<std::uint64_t>::max() - value) {
-				return 0;
-			}
+	const std::uint64_t last = numbers.back();
 
-			result += value;
-		}
-		else if (ops.state[num - 1] == 1) {
-			if (result > std::numeric_limits<std::uint64_t>::max() / value) {
-				return 0;
-			}
+	if (numbers.size() == 1) {
+		return target == last;
+	}
 
-			result *= value;
-		}
-		else {
-			result = concat(result, value);
+	auto rest = numbers.first(numbers.size() - 1);
 
-			if (result == 0) {
-				return 0;
-			}
+	if (auto factor = digit_factor(numbers.back()); target % factor == last) {
+		if (can_make(target / factor, rest)) {
+			return true;
 		}
+	}
 
-		if (result > target) {
-			return 0;
+	// Anything times zero is zero
+	if (last == 0) {
+		if (target == 0) {
+			return true;
 		}
 	}
+	else if (target % last == 0 && can_make(target / last, rest)) {
+		return true;
+	}
 
-	return result;
+	return target >= last && can_make(target - last, rest);
 }
 
-int main()
-{
-	auto equations = read_equations();
-
-	std::println("read {} equations", equations.size());
+struct Result {
+	std::size_t num_equations = 0;
+	std::uint64_t calibration_result = 0;
+};
 
+Result solve(const std::vector<Equation> &equations)
+{
 	auto can_be_true = [](const auto &equation) {
-		for (Operators ops; ops.state[equation.second.size()] == 0; ops.next()) {
-			if (evaluate(equation, ops, equation.first) == equation.first) {
-				return true;
-			}
-		}
-
-		return false;
+		return !equation.second.empty() && can_make(equation.first, equation.second);
 	};
 
 	auto calibration_result = std::ranges::fold_left(
@@ -130,5 +106,15 @@ int main()
 		std::plus{}
 	);
 
-	std::println("total calibration result is {}", calibration_result);
+	return {equations.size(), calibration_result};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "read {} equations", result.num_equations);
+	std::println(out, "total calibration result is {}", result.calibration_result);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
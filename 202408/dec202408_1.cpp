@@ -4,7 +4,7 @@
 
 #include <algorithm>
 #include <array>
-#include <iostream>
+#include <cstdio>
 #include <iterator>
 #include <print>
 #include <ranges>
@@ -13,6 +13,11 @@
 #include <utility>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
 auto get_antennas(const auto &map)
 {
 	std::unordered_map<char, std::vector<std::pair<int, int>>> antennas;
@@ -28,11 +33,15 @@ auto get_antennas(const auto &map)
 	return antennas;
 }
 
-int main()
+std::vector<std::string> parse(aoc::Scanner &in)
 {
-	std::vector<std::string> map(std::istream_iterator<std::string>{std::cin},
-	                             std::istream_iterator<std::string>{});
+	auto lines = in.lines();
 
+	return std::vector<std::string>(lines.begin(), lines.end());
+}
+
+long solve(std::vector<std::string> map)
+{
 	auto antennas = get_antennas(map);
 
 	for (const auto &[_, positions] : antennas) {
@@ -63,7 +72,14 @@ int main()
 	}
 
 	// Count number of #s
-	auto num_antinodes = std::ranges::count(map | std::views::join, '#');
+	return std::ranges::count(map | std::views::join, '#');
+}
 
-	std::println("{} antinodes", num_antinodes);
+void print(std::FILE *out, long num_antinodes)
+{
+	std::println(out, "{} antinodes", num_antinodes);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
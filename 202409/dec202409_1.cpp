@@ -2,13 +2,19 @@
 // Advent of Code 2024, day 9, part one
 //
 
-#include <iostream>
+#include <cstdio>
 #include <print>
 #include <ranges>
+#include <string_view>
 #include <utility>
 #include <vector>
 
-auto read_map()
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+auto read_map(std::string_view disk_map)
 {
 	std::vector<int> drive;
 
@@ -16,7 +22,11 @@ auto read_map()
 	bool free_space = false;
 
 	// Read disk map and convert to blocks in drive
-	for (char ch = ' '; std::cin >> ch && ch >= '0' && ch <= '9'; ) {
+	for (char ch : disk_map) {
+		if (ch < '0' || ch > '9') {
+			break;
+		}
+
 		int size = ch - '0';
 
 		drive.insert(drive.end(), size, free_space ? -1 : id);
@@ -68,11 +78,23 @@ auto filesystem_checksum(const auto &drive)
 	return checksum;
 }
 
-int main()
+std::vector<int> parse(aoc::Scanner &in)
 {
-	auto drive = read_map();
+	return read_map(in.remaining());
+}
 
+unsigned long long solve(std::vector<int> drive)
+{
 	compact_drive(drive);
 
-	std::println("checksum is {}", filesystem_checksum(drive));
+	return filesystem_checksum(drive);
+}
+
+void print(std::FILE *out, unsigned long long checksum)
+{
+	std::println(out, "checksum is {}", checksum);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -2,12 +2,18 @@
 // Advent of Code 2024, day 9, part two
 //
 
-#include <iostream>
+#include <cstdio>
 #include <list>
 #include <print>
+#include <string_view>
 #include <tuple>
 
-auto read_map()
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+auto read_map(std::string_view disk_map)
 {
 	std::list<std::tuple<int, int, bool>> drive;
 
@@ -15,7 +21,11 @@ auto read_map()
 	bool free_space = false;
 
 	// Read disk map and convert to blocks in drive
-	for (char ch = ' '; std::cin >> ch && ch >= '0' && ch <= '9'; ) {
+	for (char ch : disk_map) {
+		if (ch < '0' || ch > '9') {
+			break;
+		}
+
 		int size = ch - '0';
 
 		if (free_space) {
@@ -85,11 +95,23 @@ auto filesystem_checksum(const auto &drive)
 	return checksum;
 }
 
-int main()
+std::list<std::tuple<int, int, bool>> parse(aoc::Scanner &in)
 {
-	auto drive = read_map();
+	return read_map(in.remaining());
+}
 
+unsigned long long solve(std::list<std::tuple<int, int, bool>> drive)
+{
 	compact_drive(drive);
 
-	std::println("checksum is {}", filesystem_checksum(drive));
+	return filesystem_checksum(drive);
 }
+
+void print(std::FILE *out, unsigned long long checksum)
+{
+	std::println(out, "checksum is {}", checksum);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
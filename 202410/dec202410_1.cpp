@@ -2,50 +2,26 @@
 // Advent of Code 2024, day 10, part one
 //
 
-#include <array>
-#include <cstddef>
-#include <functional>
-#include <iostream>
+#include <cstdio>
 #include <print>
 #include <queue>
-#include <ranges>
-#include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
-
-auto read_and_pad_map()
-{
-	std::vector<std::string> map;
+#include "coord_set.h"
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
 
-	// Pad map with '.'
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back("." + line + ".");
-	}
-
-	map.insert(map.begin(), std::string(map.front().size(), '.'));
-	map.push_back(std::string(map.front().size(), '.'));
-
-	return map;
-}
+namespace {
 
 auto get_trailheads(const auto &map)
 {
 	std::vector<std::pair<int, int>> trailheads;
 
-	for (const auto &[y, row] : std::views::enumerate(map)) {
-		for (const auto &[x, height] : std::views::enumerate(row)) {
-			if (height == '0') {
+	for (int y = 0; y < map.height(); ++y) {
+		for (int x = 0; x < map.width(); ++x) {
+			if (map(x, y) == '0') {
 				trailheads.emplace_back(x, y);
 			}
 		}
@@ -56,11 +32,7 @@ auto get_trailheads(const auto &map)
 
 auto trailhead_score(const auto &map, int start_x, int start_y)
 {
-	constexpr std::array<std::array<int, 2>, 4> directions = {{
-		{ 0, 1 }, { -1, 0 }, { 0, -1 }, { 1, 0 }
-	}};
-
-	std::unordered_set<std::pair<int, int>, PairHash> seen;
+	aoc::CoordSet seen(map);
 
 	std::queue<std::pair<int, int>> queue;
 
@@ -72,17 +44,17 @@ auto trailhead_score(const auto &map, int start_x, int start_y)
 		auto [x, y] = queue.front();
 		queue.pop();
 
-		if (auto [_, success] = seen.emplace(x, y); !success) {
+		if (!seen.insert(x, y)) {
 			continue;
 		}
 
-		if (map[y][x] == '9') {
+		if (map(x, y) == '9') {
 			++score;
 			continue;
 		}
 
-		for (auto [dx, dy] : directions) {
-			if (map[y + dy][x + dx] == map[y][x] + 1) {
+		for (auto [dx, dy] : aoc::directions4) {
+			if (map(x + dx, y + dy) == map(x, y) + 1) {
 				queue.emplace(x + dx, y + dy);
 			}
 		}
@@ -91,10 +63,14 @@ auto trailhead_score(const auto &map, int start_x, int start_y)
 	return score;
 }
 
-int main()
+aoc::Grid<char> parse(aoc::Scanner &in)
 {
-	auto map = read_and_pad_map();
+	// Pad map with '.'
+	return aoc::read_grid(in, 1, '.');
+}
 
+int solve(const aoc::Grid<char> &map)
+{
 	auto trailheads = get_trailheads(map);
 
 	int trailhead_score_sum = 0;
@@ -103,5 +79,14 @@ int main()
 		trailhead_score_sum += trailhead_score(map, x, y);
 	}
 
-	std::println("trailhead score sum {}", trailhead_score_sum);
+	return trailhead_score_sum;
+}
+
+void print(std::FILE *out, int trailhead_score_sum)
+{
+	std::println(out, "trailhead score sum {}", trailhead_score_sum);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
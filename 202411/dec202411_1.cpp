@@ -3,15 +3,20 @@
 //
 
 #include <algorithm>
+#include <cstdio>
 #include <functional>
 #include <iostream>
-#include <iterator>
 #include <limits>
 #include <print>
 #include <ranges>
 #include <string>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
 
 auto evaluate_stone(long stone, int depth)
 {
@@ -44,16 +49,25 @@ auto evaluate_stone(long stone, int depth)
 }
 
 
-int main()
+std::vector<long> parse(aoc::Scanner &in)
 {
-	std::vector<long> stones(std::istream_iterator<long>{std::cin},
-	                         std::istream_iterator<long>{});
+	return aoc::numbers<long>(in.remaining());
+}
 
-	long num_stones = std::ranges::fold_left(stones | std::views::transform(
+long solve(const std::vector<long> &stones)
+{
+	return std::ranges::fold_left(stones | std::views::transform(
 		[](long stone) { return evaluate_stone(stone, 25); }),
 		0L,
 		std::plus{}
 	);
+}
 
-	std::println("number of stones is {}", num_stones);
+void print(std::FILE *out, long num_stones)
+{
+	std::println(out, "number of stones is {}", num_stones);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
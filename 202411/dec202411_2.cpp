@@ -3,32 +3,26 @@
 //
 
 #include <algorithm>
-#include <cstddef>
+#include <cstdio>
 #include <functional>
 #include <iostream>
-#include <iterator>
 #include <limits>
 #include <print>
 #include <ranges>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
+#include "flat_map.h"
+#include "input.h"
+#include "solver.h"
 
-auto evaluate_stone(long stone, int depth)
-{
-	static std::unordered_map<std::pair<long, int>, long, PairHash> memory;
+namespace {
+
+using Memory = aoc::FlatMap<std::pair<long, int>, long>;
 
+auto evaluate_stone(long stone, int depth, Memory &memory)
+{
 	if (depth == 0) {
 		return 1L;
 	}
@@ -42,20 +36,20 @@ auto evaluate_stone(long stone, int depth)
 	long num_stones = 0;
 
 	if (stone == 0) {
-		num_stones = evaluate_stone(1, depth - 1);
+		num_stones = evaluate_stone(1, depth - 1, memory);
 	}
 	else if (as_str.size() % 2 == 0) {
 		long left = std::stol(as_str.substr(0, as_str.size() / 2));
 		long right = std::stol(as_str.substr(as_str.size() / 2, std::string::npos));
 
-		num_stones = evaluate_stone(left, depth - 1) + evaluate_stone(right, depth - 1);
+		num_stones = evaluate_stone(left, depth - 1, memory) + evaluate_stone(right, depth - 1, memory);
 	}
 	else {
 		if (stone > std::numeric_limits<long>::max() / 2024) {
 			std::println(std::cerr, "overflow");
 		}
 
-		num_stones = evaluate_stone(stone * 2024, depth - 1);
+		num_stones = evaluate_stone(stone * 2024, depth - 1, memory);
 	}
 
 	memory.emplace(std::make_pair(stone, depth), num_stones);
@@ -64,16 +58,27 @@ auto evaluate_stone(long stone, int depth)
 }
 
 
-int main()
+std::vector<long> parse(aoc::Scanner &in)
 {
-	std::vector<long> stones(std::istream_iterator<long>{std::cin},
-	                         std::istream_iterator<long>{});
+	return aoc::numbers<long>(in.remaining());
+}
 
-	long num_stones = std::ranges::fold_left(stones | std::views::transform(
-		[](long stone) { return evaluate_stone(stone, 75); }),
+long solve(const std::vector<long> &stones)
+{
+	Memory memory;
+
+	return std::ranges::fold_left(stones | std::views::transform(
+		[&memory](long stone) { return evaluate_stone(stone, 75, memory); }),
 		0L,
 		std::plus{}
 	);
+}
 
-	std::println("number of stones is {}", num_stones);
+void print(std::FILE *out, long num_stones)
+{
+	std::println(out, "number of stones is {}", num_stones);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
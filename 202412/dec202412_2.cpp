@@ -3,42 +3,18 @@
 //
 
 #include <algorithm>
-#include <array>
-#include <cstddef>
-#include <functional>
-#include <iostream>
+#include <cstdio>
 #include <print>
 #include <queue>
 #include <ranges>
-#include <string>
-#include <unordered_set>
 #include <utility>
-#include <vector>
-
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
-
-auto read_and_pad_map()
-{
-	std::vector<std::string> map;
-
-	// Pad map with '.'
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back("." + line + ".");
-	}
 
-	map.insert(map.begin(), std::string(map.front().size(), '.'));
-	map.push_back(std::string(map.front().size(), '.'));
+#include "coord_set.h"
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
 
-	return map;
-}
+namespace {
 
 auto count_sides(const auto &seen)
 {
@@ -88,17 +64,13 @@ auto count_sides(const auto &seen)
 
 auto count_region(auto &map, int start_x, int start_y)
 {
-	constexpr std::array<std::array<int, 2>, 4> directions = {{
-		{ 0, 1 }, { -1, 0 }, { 0, -1 }, { 1, 0 }
-	}};
-
-	std::unordered_set<std::pair<int, int>, PairHash> seen;
+	aoc::CoordSet seen(map);
 
 	std::queue<std::pair<int, int>> queue;
 
 	queue.emplace(start_x, start_y);
 
-	const auto plant = map[start_y][start_x];
+	const auto plant = map(start_x, start_y);
 
 	int area = 0;
 
@@ -106,38 +78,42 @@ auto count_region(auto &map, int start_x, int start_y)
 		auto [x, y] = queue.front();
 		queue.pop();
 
-		if (map[y][x] != plant) {
+		if (map(x, y) != plant) {
 			continue;
 		}
 
-		if (auto [_, success] = seen.emplace(x, y); !success) {
+		if (!seen.insert(x, y)) {
 			continue;
 		}
 
 		++area;
 
-		for (auto [dx, dy] : directions) {
+		for (auto [dx, dy] : aoc::directions4) {
 			queue.emplace(x + dx, y + dy);
 		}
 	}
 
 	// Remove area from map
 	for (auto [x, y] : seen) {
-		map[y][x] = '.';
+		map(x, y) = '.';
 	}
 
 	return std::make_pair(area, count_sides(seen));
 }
 
-int main()
+aoc::Grid<char> parse(aoc::Scanner &in)
 {
-	auto map = read_and_pad_map();
+	// Pad map with '.'
+	return aoc::read_grid(in, 1, '.');
+}
 
+long solve(aoc::Grid<char> map)
+{
 	long total_price = 0;
 
-	for (const auto &[y, row] : std::views::enumerate(map)) {
-		for (const auto &[x, plant] : std::views::enumerate(row)) {
-			if (plant >= 'A' && plant <= 'Z') {
+	for (int y = 0; y < map.height(); ++y) {
+		for (int x = 0; x < map.width(); ++x) {
+			if (auto plant = map(x, y); plant >= 'A' && plant <= 'Z') {
 				auto [area, perimeter] = count_region(map, x, y);
 
 				total_price += area * perimeter;
@@ -145,5 +121,14 @@ int main()
 		}
 	}
 
-	std::println("total price {}", total_price);
+	return total_price;
+}
+
+void print(std::FILE *out, long total_price)
+{
+	std::println(out, "total price {}", total_price);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
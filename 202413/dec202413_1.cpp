@@ -4,6 +4,12 @@
 
 #include <cstdio>
 #include <print>
+#include <vector>
+
+#include "input.h"
+#include "solver.h"
+
+namespace {
 
 auto lowest_token_cost(int ax, int ay, int bx, int by, int prize_x, int prize_y)
 {
@@ -27,26 +33,42 @@ auto lowest_token_cost(int ax, int ay, int bx, int by, int prize_x, int prize_y)
 	return 0;
 }
 
-int main()
+struct Machine {
+	int ax = 0;
+	int ay = 0;
+	int bx = 0;
+	int by = 0;
+	int prize_x = 0;
+	int prize_y = 0;
+};
+
+std::vector<Machine> parse(aoc::Scanner &in)
 {
-	int tokens_for_all_prizes = 0;
+	std::vector<Machine> machines;
 
-	for (;;) {
-		int ax = 0;
-		int ay = 0;
-		int bx = 0;
-		int by = 0;
-		int prize_x = 0;
-		int prize_y = 0;
-
-		if (std::scanf("Button A: X+%d, Y+%d\n"
-		               "Button B: X+%d, Y+%d\n"
-		               "Prize: X=%d, Y=%d\n", &ax, &ay, &bx, &by, &prize_x, &prize_y) != 6) {
-			break;
-		}
+	for (Machine m; in.next(m.ax, m.ay, m.bx, m.by, m.prize_x, m.prize_y); ) {
+		machines.push_back(m);
+	}
+
+	return machines;
+}
 
-		tokens_for_all_prizes += lowest_token_cost(ax, ay, bx, by, prize_x, prize_y);
+int solve(const std::vector<Machine> &machines)
+{
+	int tokens_for_all_prizes = 0;
+
+	for (const auto &m : machines) {
+		tokens_for_all_prizes += lowest_token_cost(m.ax, m.ay, m.bx, m.by, m.prize_x, m.prize_y);
 	}
 
-	std::println("{}", tokens_for_all_prizes);
+	return tokens_for_all_prizes;
+}
+
+void print(std::FILE *out, int tokens_for_all_prizes)
+{
+	std::println(out, "{}", tokens_for_all_prizes);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
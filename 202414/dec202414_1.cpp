@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdio>
 #include <functional>
 #include <print>
@@ -11,20 +12,23 @@
 #include <utility>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
 struct Robot {
 	std::pair<int, int> pos;
 	std::pair<int, int> vel;
 };
 
-auto read_robots()
+std::vector<Robot> parse(aoc::Scanner &in)
 {
 	std::vector<Robot> robots;
 
 	Robot r = {};
 
-	while (std::scanf("p=%d,%d v=%d,%d\n",
-	                  &r.pos.first, &r.pos.second,
-			  &r.vel.first, &r.vel.second) == 4) {
+	while (in.next(r.pos.first, r.pos.second, r.vel.first, r.vel.second)) {
 		robots.push_back(r);
 	}
 
@@ -73,15 +77,26 @@ auto safety_factor(const auto &robots)
 	return std::ranges::fold_left(quadrant_counts | std::views::join, 1, std::multiplies{});
 }
 
-int main()
-{
-	auto robots = read_robots();
-
-	std::println("read {} robots", robots.size());
+struct Result {
+	std::size_t num_robots = 0;
+	int safety_factor = 0;
+};
 
+Result solve(std::vector<Robot> robots)
+{
 	for (int i = 0; i < 100; ++i) {
 		step_robots(robots, 101, 103);
 	}
 
-	std::println("{}", safety_factor(robots));
+	return {robots.size(), safety_factor(robots)};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "read {} robots", result.num_robots);
+	std::println(out, "{}", result.safety_factor);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
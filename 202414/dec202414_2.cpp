@@ -4,26 +4,30 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdio>
 #include <print>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
 struct Robot {
 	std::pair<int, int> pos;
 	std::pair<int, int> vel;
 };
 
-auto read_robots()
+std::vector<Robot> parse(aoc::Scanner &in)
 {
 	std::vector<Robot> robots;
 
 	Robot r = {};
 
-	while (std::scanf("p=%d,%d v=%d,%d\n",
-	                  &r.pos.first, &r.pos.second,
-			  &r.vel.first, &r.vel.second) == 4) {
+	while (in.next(r.pos.first, r.pos.second, r.vel.first, r.vel.second)) {
 		robots.push_back(r);
 	}
 
@@ -55,7 +59,7 @@ void step_robots(auto &robots, int width, int height)
 	}
 }
 
-void print_map(const auto &robots)
+void print_map(std::FILE *out, const auto &robots)
 {
 	std::array<std::string, 103> map;
 
@@ -70,7 +74,7 @@ void print_map(const auto &robots)
 	}
 
 	for (const auto &line : map) {
-		std::println("{}", line);
+		std::println(out, "{}", line);
 	}
 }
 
@@ -106,20 +110,32 @@ bool has_line(auto &robots)
 	return false;
 }
 
-int main()
-{
-	auto robots = read_robots();
+struct Result {
+	std::size_t num_robots = 0;
+	long seconds = 0;
+	std::vector<Robot> robots;
+};
 
-	std::println("read {} robots", robots.size());
+Result solve(std::vector<Robot> robots)
+{
+	const auto num_robots = robots.size();
 
 	for (long seconds = 1; ; ++seconds) {
 		step_robots(robots, 101, 103);
 
 		if (has_line(robots)) {
-			std::println("at {} seconds", seconds);
-			print_map(robots);
-			break;
+			return {num_robots, seconds, std::move(robots)};
 		}
-
 	}
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "read {} robots", result.num_robots);
+	std::println(out, "at {} seconds", result.seconds);
+	print_map(out, result.robots);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -2,50 +2,46 @@
 // Advent of Code 2024, day 15, part one
 //
 
-#include <algorithm>
-#include <cstdlib>
-#include <iostream>
-#include <iterator>
+#include <cstddef>
+#include <cstdio>
+#include <format>
 #include <print>
-#include <ranges>
 #include <string>
+#include <string_view>
 #include <utility>
-#include <vector>
 
-auto read_map()
-{
-	std::vector<std::string> map;
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back(std::move(line));
-	}
+namespace {
 
-	return map;
-}
-
-auto read_moves()
+auto read_moves(aoc::Scanner &in)
 {
 	std::string moves;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
 		moves.append(line);
 	}
 
 	return moves;
 }
 
-void print_map(const auto &map)
+void print_map(std::FILE *out, const auto &map)
 {
-	std::ranges::copy(map, std::ostream_iterator<std::string>(std::cout, "\n"));
+	for (int y = 0; y < map.height(); ++y) {
+		auto row = map.row(y);
+		std::println(out, "{}", std::string_view(row.data(), row.size()));
+	}
 }
 
 auto gps_sum(const auto &map)
 {
 	long sum = 0;
 
-	for (const auto &[y, row] : std::views::enumerate(map)) {
-		for (const auto &[x, ch] : std::views::enumerate(row)) {
-			if (ch == 'O') {
+	for (int y = 0; y < map.height(); ++y) {
+		for (int x = 0; x < map.width(); ++x) {
+			if (map(x, y) == 'O') {
 				sum += y * 100 + x;
 			}
 		}
@@ -54,25 +50,31 @@ auto gps_sum(const auto &map)
 	return sum;
 }
 
-int main()
-{
-	auto map = read_map();
+struct Warehouse {
+	aoc::Grid<char> map;
+	std::string moves;
+};
 
-	std::println("map {}x{}", map.front().size(), map.size());
+struct Result {
+	std::size_t num_moves = 0;
+	aoc::Grid<char> map;
+	long gps_sum = 0;
+};
 
-	auto moves = read_moves();
+Warehouse parse(aoc::Scanner &in)
+{
+	auto map = aoc::read_grid(in);
+	auto moves = read_moves(in);
+
+	return {std::move(map), std::move(moves)};
+}
 
-	std::println("moves {}", moves.size());
+Result solve(Warehouse warehouse)
+{
+	auto &[map, moves] = warehouse;
 
 	// Find robot
-	auto [x, y] = [&map]() -> std::pair<int, int> {
-		for (const auto &[y, str] : std::views::enumerate(map)) {
-			if (auto x = str.find('@'); x != std::string::npos) {
-				return {x, y};
-			}
-		}
-		return {-1, -1};
-	}();
+	auto [x, y] = map.coords(map.find('@'));
 
 	for (auto move : moves) {
 		const auto [dx, dy] = [&move]() -> std::pair<int, int> {
@@ -86,8 +88,7 @@ int main()
 			case '<':
 				return {-1, 0};
 			default:
-				std::println(std::cerr, "bad move '{}'", move);
-				std::exit(1);
+				throw aoc::InputError(std::format("bad move '{}'", move));
 			}
 		}();
 
@@ -95,26 +96,40 @@ int main()
 		auto box_y = y;
 
 		// Skip over any boxes
-		while (map[box_y + dy][box_x + dx] == 'O') {
+		while (map(box_x + dx, box_y + dy) == 'O') {
 			box_x += dx;
 			box_y += dy;
 		}
 
 		// If there is a wall at the end, move is blocked
-		if (map[box_y + dy][box_x + dx] == '#') {
+		if (map(box_x + dx, box_y + dy) == '#') {
 			continue;
 		}
 
 		// Any line of boxes is moved here by writing a box after
 		// the end and overwriting the first with the robot
-		map[y][x] = '.';
-		map[box_y + dy][box_x + dx] = 'O';
+		map(x, y) = '.';
+		map(box_x + dx, box_y + dy) = 'O';
 		x += dx;
 		y += dy;
-		map[y][x] = '@';
+		map(x, y) = '@';
 	}
 
-	print_map(map);
+	auto sum = gps_sum(map);
+
+	return {moves.size(), std::move(map), sum};
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "map {}x{}", result.map.width(), result.map.height());
+	std::println(out, "moves {}", result.num_moves);
+
+	print_map(out, result.map);
 
-	std::println("GPS sum {}", gps_sum(map));
+	std::println(out, "GPS sum {}", result.gps_sum);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
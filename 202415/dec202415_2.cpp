@@ -2,19 +2,24 @@
 // Advent of Code 2024, day 15, part two
 //
 
-#include <algorithm>
-#include <cstdlib>
-#include <iostream>
-#include <iterator>
+#include <cstddef>
+#include <cstdio>
+#include <format>
 #include <print>
 #include <queue>
-#include <ranges>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
 
-auto expand_line(const std::string &line)
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+auto expand_line(std::string_view line)
 {
 	std::string expanded_line;
 
@@ -35,48 +40,50 @@ auto expand_line(const std::string &line)
 			expanded_line.append("@.");
 			break;
 		default:
-			std::println(std::cerr, "bad map character '{}'", ch);
-			std::exit(1);
+			throw aoc::InputError(std::format("bad map character '{}'", ch));
 		}
 	}
 
 	return expanded_line;
 }
 
-auto read_map()
+auto read_map(aoc::Scanner &in)
 {
-	std::vector<std::string> map;
+	std::vector<std::string> lines;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back(expand_line(line));
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
+		lines.push_back(expand_line(line));
 	}
 
-	return map;
+	return aoc::make_grid(lines);
 }
 
-auto read_moves()
+auto read_moves(aoc::Scanner &in)
 {
 	std::string moves;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
 		moves.append(line);
 	}
 
 	return moves;
 }
 
-void print_map(const auto &map)
+void print_map(std::FILE *out, const auto &map)
 {
-	std::ranges::copy(map, std::ostream_iterator<std::string>(std::cout, "\n"));
+	for (int y = 0; y < map.height(); ++y) {
+		auto row = map.row(y);
+		std::println(out, "{}", std::string_view(row.data(), row.size()));
+	}
 }
 
 auto gps_sum(const auto &map)
 {
 	long sum = 0;
 
-	for (const auto &[y, row] : std::views::enumerate(map)) {
-		for (const auto &[x, ch] : std::views::enumerate(row)) {
-			if (ch == '[') {
+	for (int y = 0; y < map.height(); ++y) {
+		for (int x = 0; x < map.width(); ++x) {
+			if (map(x, y) == '[') {
 				sum += y * 100 + x;
 			}
 		}
@@ -94,7 +101,7 @@ auto get_characters_to_move(const auto &map, int x, int y, int dx, int dy)
 	auto add_box = [&](int x, int y, int dy) {
 		// dbox is the extra offset in the x direction to get the
 		// other character of the box
-		auto dbox = map[y][x] == '[' ? 1 : -1;
+		auto dbox = map(x, y) == '[' ? 1 : -1;
 
 		// If we come from above or below, we have to handle both
 		// characters of the box, whereas if you come from the left
@@ -106,11 +113,11 @@ auto get_characters_to_move(const auto &map, int x, int y, int dx, int dy)
 		queue.emplace(x + dbox, y);
 
 		// Store both characters of the box so we can move them later
-		box_chars.emplace_back(x, y, map[y][x]);
-		box_chars.emplace_back(x + dbox, y, map[y][x + dbox]);
+		box_chars.emplace_back(x, y, map(x, y));
+		box_chars.emplace_back(x + dbox, y, map(x + dbox, y));
 	};
 
-	if (map[y + dy][x + dx] != '[' && map[y + dy][x + dx] != ']') {
+	if (map(x + dx, y + dy) != '[' && map(x + dx, y + dy) != ']') {
 		return box_chars;
 	}
 
@@ -124,12 +131,12 @@ auto get_characters_to_move(const auto &map, int x, int y, int dx, int dy)
 
 		// If there is a wall in front of any of the boxes we are
 		// moving, the entire move is blocked
-		if (map[box_y + dy][box_x + dx] == '#') {
+		if (map(box_x + dx, box_y + dy) == '#') {
 			blocked = true;
 			break;
 		}
 
-		if (map[box_y + dy][box_x + dx] == '.') {
+		if (map(box_x + dx, box_y + dy) == '.') {
 			continue;
 		}
 
@@ -144,25 +151,31 @@ auto get_characters_to_move(const auto &map, int x, int y, int dx, int dy)
 	return box_chars;
 }
 
-int main()
-{
-	auto map = read_map();
+struct Warehouse {
+	aoc::Grid<char> map;
+	std::string moves;
+};
 
-	std::println("map {}x{}", map.front().size(), map.size());
+struct Result {
+	std::size_t num_moves = 0;
+	aoc::Grid<char> map;
+	long gps_sum = 0;
+};
 
-	auto moves = read_moves();
+Warehouse parse(aoc::Scanner &in)
+{
+	auto map = read_map(in);
+	auto moves = read_moves(in);
+
+	return {std::move(map), std::move(moves)};
+}
 
-	std::println("moves {}", moves.size());
+Result solve(Warehouse warehouse)
+{
+	auto &[map, moves] = warehouse;
 
 	// Find robot
-	auto [x, y] = [&map]() -> std::pair<int, int> {
-		for (const auto &[y, str] : std::views::enumerate(map)) {
-			if (auto x = str.find('@'); x != std::string::npos) {
-				return {x, y};
-			}
-		}
-		return {-1, -1};
-	}();
+	auto [x, y] = map.coords(map.find('@'));
 
 	for (auto move : moves) {
 		const auto [dx, dy] = [&move]() -> std::pair<int, int> {
@@ -176,22 +189,21 @@ int main()
 			case '<':
 				return {-1, 0};
 			default:
-				std::println(std::cerr, "bad move '{}'", move);
-				std::exit(1);
+				throw aoc::InputError(std::format("bad move '{}'", move));
 			}
 		}();
 
 		// Check if immediately blocked
-		if (map[y + dy][x + dx] == '#') {
+		if (map(x + dx, y + dy) == '#') {
 			continue;
 		}
 
 		// Check if simple move
-		if (map[y + dy][x + dx] == '.') {
-			map[y][x] = '.';
+		if (map(x + dx, y + dy) == '.') {
+			map(x, y) = '.';
 			x += dx;
 			y += dy;
-			map[y][x] = '@';
+			map(x, y) = '@';
 			continue;
 		}
 
@@ -205,22 +217,36 @@ int main()
 
 		// Remove all characters belonging to boxes to be moved
 		for (auto [bx, by, _] : box_chars) {
-			map[by][bx] = '.';
+			map(bx, by) = '.';
 		}
 
 		// Add moved characters for boxes
 		for (auto [bx, by, ch] : box_chars) {
-			map[by + dy][bx + dx] = ch;
+			map(bx + dx, by + dy) = ch;
 		}
 
 		// Move robot
-		map[y][x] = '.';
+		map(x, y) = '.';
 		x += dx;
 		y += dy;
-		map[y][x] = '@';
+		map(x, y) = '@';
 	}
 
-	print_map(map);
+	auto sum = gps_sum(map);
 
-	std::println("GPS sum {}", gps_sum(map));
+	return {moves.size(), std::move(map), sum};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "map {}x{}", result.map.width(), result.map.height());
+	std::println(out, "moves {}", result.num_moves);
+
+	print_map(out, result.map);
+
+	std::println(out, "GPS sum {}", result.gps_sum);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -2,85 +2,64 @@
 // Advent of Code 2024, day 16, part one
 //
 
-#include <cstddef>
+#include <cstdio>
 #include <functional>
-#include <iostream>
+#include <limits>
 #include <print>
 #include <queue>
-#include <ranges>
-#include <string>
 #include <tuple>
-#include <unordered_map>
-#include <utility>
 #include <vector>
 
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
 
-auto read_map()
-{
-	std::vector<std::string> map;
+namespace {
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back(std::move(line));
-	}
+struct Result {
+	int width = 0;
+	int height = 0;
+	long score = 0;
+};
 
-	return map;
+aoc::Grid<char> parse(aoc::Scanner &in)
+{
+	return aoc::read_grid(in);
 }
 
-int main()
+Result solve(const aoc::Grid<char> &map)
 {
-	auto map = read_map();
-
-	std::println("map {}x{}", map.front().size(), map.size());
-
 	// Find start
-	auto [start_x, start_y] = [&map]() -> std::pair<int, int> {
-		for (const auto &[y, str] : std::views::enumerate(map)) {
-			if (auto x = str.find('S'); x != std::string::npos) {
-				return {x, y};
-			}
-		}
-		return {-1, -1};
-	}();
+	auto [start_x, start_y] = map.coords(map.find('S'));
 
-	std::unordered_map<std::pair<int, int>, long, PairHash> scores;
+	// Lowest score found for each position
+	aoc::Grid<long> scores(map.width(), map.height(), 0, std::numeric_limits<long>::max());
 
 	std::priority_queue<std::tuple<long, int, int, int, int>,
 	                    std::vector<std::tuple<long, int, int, int, int>>,
 			    std::greater<>> pqueue;
 
 	auto check_position = [&](int x, int y, int dx, int dy, long score) {
-		if (map[y][x] == '#') {
+		if (map(x, y) == '#') {
 			return;
 		}
 
-		if (auto [it, success] = scores.insert({{x, y}, score}); !success) {
-			if (score < it->second) {
-				it->second = score;
-				pqueue.emplace(score, x, y, dx, dy);
-			}
-		}
-		else {
+		if (score < scores(x, y)) {
+			scores(x, y) = score;
 			pqueue.emplace(score, x, y, dx, dy);
 		}
 	};
 
 	pqueue.emplace(0, start_x, start_y, 1, 0);
 
+	long best_score = 0;
+
 	while (!pqueue.empty()) {
 		auto [score, x, y, dx, dy] = pqueue.top();
 		pqueue.pop();
 
-		if (map[y][x] == 'E') {
-			std::println("score {}", score);
+		if (map(x, y) == 'E') {
+			best_score = score;
 			break;
 		}
 
@@ -88,4 +67,16 @@ int main()
 		check_position(x - dy, y + dx, -dy, dx, score + 1001);
 		check_position(x + dy, y - dx, dy, -dx, score + 1001);
 	}
+
+	return {map.width(), map.height(), best_score};
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "map {}x{}", result.width, result.height);
+	std::println(out, "score {}", result.score);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
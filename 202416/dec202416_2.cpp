@@ -4,60 +4,32 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdio>
 #include <cstdlib>
-#include <iostream>
+#include <functional>
+#include <limits>
 #include <print>
 #include <queue>
-#include <ranges>
-#include <string>
 #include <tuple>
-#include <unordered_map>
-#include <utility>
 #include <vector>
 
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
-
-struct TupleHash {
-	template<typename... Ts>
-	std::size_t operator()(const std::tuple<Ts...> &tuple) const noexcept
-	{
-		std::size_t hash = 17;
-		std::apply([&hash](const auto &... args) {
-			(..., (hash = hash * 37 + std::hash<Ts>()(args)));
-		}, tuple);
-		return hash;
-	}
-};
-
-auto read_map()
-{
-	std::vector<std::string> map;
+#include "flat_map.h"
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back(std::move(line));
-	}
+namespace {
 
-	return map;
-}
+using Seen = aoc::FlatMap<std::tuple<int, int, int, int>, long>;
 
 bool mark_path_recursive(auto &map, int x, int y, int dx, int dy, long score,
-                         long target_score, int end_x, int end_y)
+                         long target_score, int end_x, int end_y, Seen &seen)
 {
-	static std::unordered_map<std::tuple<int, int, int, int>, long, TupleHash> seen;
-
-	if (map[y][x] == 'E') {
+	if (map(x, y) == 'E') {
 		return score == target_score;
 	}
 
-	if (map[y][x] == '#') {
+	if (map(x, y) == '#') {
 		return false;
 	}
 
@@ -77,12 +49,12 @@ bool mark_path_recursive(auto &map, int x, int y, int dx, int dy, long score,
 		it->second = score;
 	}
 
-	auto p1 = mark_path_recursive(map, x + dx, y + dy, dx, dy, score + 1, target_score, end_x, end_y);
-	auto p2 = mark_path_recursive(map, x - dy, y + dx, -dy, dx, score + 1001, target_score, end_x, end_y);
-	auto p3 = mark_path_recursive(map, x + dy, y - dx, dy, -dx, score + 1001, target_score, end_x, end_y);
+	auto p1 = mark_path_recursive(map, x + dx, y + dy, dx, dy, score + 1, target_score, end_x, end_y, seen);
+	auto p2 = mark_path_recursive(map, x - dy, y + dx, -dy, dx, score + 1001, target_score, end_x, end_y, seen);
+	auto p3 = mark_path_recursive(map, x + dy, y - dx, dy, -dx, score + 1001, target_score, end_x, end_y, seen);
 
 	if (p1 || p2 || p3) {
-		map[y][x] = 'O';
+		map(x, y) = 'O';
 		return true;
 	}
 
@@ -92,52 +64,43 @@ bool mark_path_recursive(auto &map, int x, int y, int dx, int dy, long score,
 void mark_paths_with_score(auto &map, int start_x, int start_y, long target_score)
 {
 	// Find end
-	auto [end_x, end_y] = [&map]() -> std::pair<int, int> {
-		for (const auto &[y, str] : std::views::enumerate(map)) {
-			if (auto x = str.find('E'); x != std::string::npos) {
-				return {x, y};
-			}
-		}
-		return {-1, -1};
-	}();
+	auto [end_x, end_y] = map.coords(map.find('E'));
+
+	Seen seen;
 
-	mark_path_recursive(map, start_x, start_y, 1, 0, 0, target_score, end_x, end_y);
+	mark_path_recursive(map, start_x, start_y, 1, 0, 0, target_score, end_x, end_y, seen);
 }
 
-int main()
-{
-	auto map = read_map();
+struct Result {
+	int width = 0;
+	int height = 0;
+	std::ptrdiff_t num_tiles = 0;
+};
 
-	std::println("map {}x{}", map.front().size(), map.size());
+aoc::Grid<char> parse(aoc::Scanner &in)
+{
+	return aoc::read_grid(in);
+}
 
+Result solve(aoc::Grid<char> map)
+{
 	// Find start
-	auto [start_x, start_y] = [&map]() -> std::pair<int, int> {
-		for (const auto &[y, str] : std::views::enumerate(map)) {
-			if (auto x = str.find('S'); x != std::string::npos) {
-				return {x, y};
-			}
-		}
-		return {-1, -1};
-	}();
+	auto [start_x, start_y] = map.coords(map.find('S'));
 
-	std::unordered_map<std::pair<int, int>, long, PairHash> scores;
+	// Lowest score found for each position
+	aoc::Grid<long> scores(map.width(), map.height(), 0, std::numeric_limits<long>::max());
 
 	std::priority_queue<std::tuple<long, int, int, int, int>,
 	                    std::vector<std::tuple<long, int, int, int, int>>,
 			    std::greater<>> pqueue;
 
 	auto check_position = [&](int x, int y, int dx, int dy, long score) {
-		if (map[y][x] == '#') {
+		if (map(x, y) == '#') {
 			return;
 		}
 
-		if (auto [it, success] = scores.insert({{x, y}, score}); !success) {
-			if (score < it->second) {
-				it->second = score;
-				pqueue.emplace(score, x, y, dx, dy);
-			}
-		}
-		else {
+		if (score < scores(x, y)) {
+			scores(x, y) = score;
 			pqueue.emplace(score, x, y, dx, dy);
 		}
 	};
@@ -148,7 +111,7 @@ int main()
 		auto [score, x, y, dx, dy] = pqueue.top();
 		pqueue.pop();
 
-		if (map[y][x] == 'E') {
+		if (map(x, y) == 'E') {
 			mark_paths_with_score(map, start_x, start_y, score);
 			break;
 		}
@@ -158,5 +121,15 @@ int main()
 		check_position(x + dy, y - dx, dy, -dx, score + 1001);
 	}
 
-	std::println("tiles on best paths {}", std::ranges::count(map | std::views::join, 'O') + 1);
+	return {map.width(), map.height(), std::ranges::count(map, 'O') + 1};
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "map {}x{}", result.width, result.height);
+	std::println(out, "tiles on best paths {}", result.num_tiles);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
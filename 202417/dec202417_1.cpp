@@ -5,53 +5,48 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
-#include <cstdlib>
+#include <cstdio>
 #include <format>
-#include <iostream>
-#include <iterator>
 #include <print>
 #include <ranges>
-#include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
 using Program = std::vector<int>;
 
-auto read_registers() -> std::tuple<std::uint64_t, std::uint64_t, std::uint64_t>
+auto read_registers(aoc::Scanner &in) -> std::tuple<std::uint64_t, std::uint64_t, std::uint64_t>
 {
-	std::string line;
-
-	std::getline(std::cin, line);
-	std::uint64_t a = std::stol(line.substr(line.find(':') + 1));
+	std::array<std::uint64_t, 3> registers = {};
 
-	std::getline(std::cin, line);
-	std::uint64_t b = std::stol(line.substr(line.find(':') + 1));
+	for (auto &reg : registers) {
+		auto line = in.line();
 
-	std::getline(std::cin, line);
-	std::uint64_t c = std::stol(line.substr(line.find(':') + 1));
+		if (!aoc::Scanner(line).next(reg)) {
+			throw aoc::InputError(std::format("bad register line '{}'", line));
+		}
+	}
 
-	return {a, b, c};
+	return {registers[0], registers[1], registers[2]};
 }
 
-Program read_program()
+Program read_program(aoc::Scanner &in)
 {
-	std::string line;
-
-	std::getline(std::cin, line);
+	std::string_view line = in.line();
 
 	if (line.empty()) {
-		std::getline(std::cin, line);
+		line = in.line();
 	}
 
-	line.erase(0, line.find(':') + 2);
-
-	return line | std::views::split(',') | std::views::transform(
-		[](const auto part) {
-			return std::stoi(std::string(part.data(), part.size()));
-		}
-	) | std::ranges::to<std::vector>();
+	return aoc::numbers<int>(line);
 }
 
 enum class Opcode { adv, bxl, bst, jnz, bxc, out, bdv, cdv };
@@ -63,9 +58,9 @@ struct Debugger {
 	bool step();
 	void run();
 
-	void print_state() const;
+	void print_state(std::FILE *out) const;
 
-	void print_output() const;
+	void print_output(std::FILE *out) const;
 
 private:
 	std::uint64_t get_combo(int combo) {
@@ -83,8 +78,7 @@ private:
 		case 6:
 			return registers[2];
 		default:
-			std::println(std::cerr, "invalid combo operand {}", combo);
-			std::exit(1);
+			throw aoc::InputError(std::format("invalid combo operand {}", combo));
 		}
 	}
 
@@ -94,15 +88,18 @@ private:
 	std::vector<int> output;
 };
 
-void Debugger::print_state() const
+void Debugger::print_state(std::FILE *out) const
 {
-	std::println("A={} B={} C={} IP={}", registers[0], registers[1], registers[2], ip);
+	std::println(out, "A={} B={} C={} IP={}", registers[0], registers[1], registers[2], ip);
 }
 
-void Debugger::print_output() const
+void Debugger::print_output(std::FILE *out) const
 {
-	std::ranges::copy(output, std::ostream_iterator<int>(std::cout, ","));
-	std::cout << '\n';
+	for (auto value : output) {
+		std::print(out, "{},", value);
+	}
+
+	std::println(out, "");
 }
 
 bool Debugger::step()
@@ -143,8 +140,7 @@ bool Debugger::step()
 		registers[2] = registers[0] >> get_combo(operand);
 		break;
 	default:
-		std::println(std::cerr, "invalid opcode {}", std::to_underlying(opcode));
-		std::exit(1);
+		throw aoc::InputError(std::format("invalid opcode {}", std::to_underlying(opcode)));
 	}
 
 	return false;
@@ -157,21 +153,49 @@ void Debugger::run()
 	}
 }
 
-int main()
-{
-	auto [a, b, c] = read_registers();
+struct Computer {
+	std::tuple<std::uint64_t, std::uint64_t, std::uint64_t> registers;
+	Program program;
+};
 
-	std::println("{} {} {}", a, b, c);
+struct Result {
+	std::tuple<std::uint64_t, std::uint64_t, std::uint64_t> registers;
+	std::size_t program_size = 0;
+	Debugger debugger;
+};
 
-	auto program = read_program();
+Computer parse(aoc::Scanner &in)
+{
+	auto registers = read_registers(in);
+	auto program = read_program(in);
 
-	std::println("program size {}", program.size());
+	return {registers, std::move(program)};
+}
 
-	Debugger debugger(program, a, b ,c);
+Result solve(const Computer &computer)
+{
+	auto [a, b, c] = computer.registers;
+
+	Debugger debugger(computer.program, a, b ,c);
 
 	debugger.run();
 
-	debugger.print_state();
+	return {computer.registers, computer.program.size(), std::move(debugger)};
+}
 
-	debugger.print_output();
+void print(std::FILE *out, const Result &result)
+{
+	auto [a, b, c] = result.registers;
+
+	std::println(out, "{} {} {}", a, b, c);
+
+	std::println(out, "program size {}", result.program_size);
+
+	result.debugger.print_state(out);
+
+	result.debugger.print_output(out);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
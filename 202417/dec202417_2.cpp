@@ -4,16 +4,22 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <format>
-#include <iostream>
 #include <limits>
 #include <print>
 #include <ranges>
-#include <string>
+#include <string_view>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
 //
 // The program 2,4,1,3,7,5,4,7,0,3,1,5,5,5,3,0 contains these instructions:
 //
@@ -35,21 +41,15 @@
 // of the output values.
 //
 
-auto read_program()
+std::vector<int> parse(aoc::Scanner &in)
 {
-	std::string line;
-
-	while (!line.starts_with("Program:")) {
-		std::getline(std::cin, line);
+	for (std::string_view line; in.getline(line); ) {
+		if (line.starts_with("Program:")) {
+			return aoc::numbers<int>(line);
+		}
 	}
 
-	line.erase(0, line.find(':') + 2);
-
-	return line | std::views::split(',') | std::views::transform(
-		[](const auto part) {
-			return std::stoi(std::string(part.data(), part.size()));
-		}
-	) | std::ranges::to<std::vector>();
+	return std::vector<int>{};
 }
 
 std::uint64_t find_quine_recursive(const auto &program, int idx, std::uint64_t cur)
@@ -114,15 +114,25 @@ auto run(std::uint64_t a, std::uint64_t b, std::uint64_t c)
 	return out;
 }
 
-int main()
-{
-	auto program = read_program();
+struct Result {
+	std::size_t program_size = 0;
+	std::uint64_t quine = 0;
+};
 
-	std::println("program size {}", program.size());
+Result solve(const std::vector<int> &program)
+{
+	return {program.size(), find_quine(program)};
+}
 
-	auto quine = find_quine(program);
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "program size {}", result.program_size);
 
-	if (quine != 0) {
-		std::println("{} -> {}", quine, run(quine, 0, 0));
+	if (result.quine != 0) {
+		std::println(out, "{} -> {}", result.quine, run(result.quine, 0, 0));
 	}
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -2,38 +2,29 @@
 // Advent of Code 2024, day 18, part two
 //
 
-#include <algorithm>
-#include <array>
 #include <cstddef>
-#include <functional>
-#include <iostream>
-#include <iterator>
+#include <cstdio>
+#include <optional>
 #include <print>
 #include <queue>
 #include <ranges>
-#include <string>
+#include <string_view>
 #include <tuple>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
+#include "coord_set.h"
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
+
+namespace {
 
-auto read_incoming_bytes()
+std::vector<std::pair<int, int>> parse(aoc::Scanner &in)
 {
 	std::vector<std::pair<int, int>> bytes;
 
-	char ch = ' ';
-
-	for (int x = -1, y = -1; std::cin >> x >> ch >> y && ch == ','; ) {
+	for (int x = -1, y = -1; in.next(x, y); ) {
 		bytes.emplace_back(x, y);
 	}
 
@@ -42,55 +33,44 @@ auto read_incoming_bytes()
 
 auto get_map(int dim)
 {
-	std::vector<std::string> map(dim + 2, std::string(dim + 2, '.'));
-
-	for (auto &ch : map.front()) {
-		ch = '#';
-	}
+	// Pad map with '#'
+	aoc::Grid<char> map(dim, dim, 1, '.');
 
-	for (auto &line : map) {
-		line.front() = '#';
-		line.back() = '#';
-	}
-
-	for (auto &ch : map.back()) {
-		ch = '#';
-	}
+	map.fill_padding('#');
 
 	return map;
 }
 
-void print_map(const auto &map)
+void print_map(std::FILE *out, const auto &map)
 {
-	std::ranges::copy(map, std::ostream_iterator<std::string>(std::cout, "\n"));
+	for (int y = -map.padding(); y < map.height() + map.padding(); ++y) {
+		auto row = map.padded_row(y);
+		std::println(out, "{}", std::string_view(row.data(), row.size()));
+	}
 }
 
 bool has_path(const auto &map)
 {
-	constexpr std::array<std::array<int, 2>, 4> directions = {{
-		{ 0, 1 }, { -1, 0 }, { 0, -1 }, { 1, 0 }
-	}};
-
-	std::unordered_set<std::pair<int, int>, PairHash> seen;
+	aoc::CoordSet seen(map);
 
 	std::queue<std::tuple<int, int, int>> queue;
 
-	queue.emplace(1, 1, 0);
+	queue.emplace(0, 0, 0);
 
 	while (!queue.empty()) {
 		auto [x, y, dist] = queue.front();
 		queue.pop();
 
-		if (x + 2 == map.front().size() && y + 2 == map.size()) {
+		if (x + 1 == map.width() && y + 1 == map.height()) {
 			return true;
 		}
 
-		if (auto [it, success] = seen.insert({x, y}); !success) {
+		if (!seen.insert(x, y)) {
 			continue;
 		}
 
-		for (auto [dx, dy] : directions) {
-			if (map[y + dy][x + dx] == '.') {
+		for (auto [dx, dy] : aoc::directions4) {
+			if (map(x + dx, y + dy) == '.') {
 				queue.emplace(x + dx, y + dy, dist + 1);
 			}
 		}
@@ -99,24 +79,40 @@ bool has_path(const auto &map)
 	return false;
 }
 
-int main()
-{
-	auto bytes = read_incoming_bytes();
-
-	std::println("{} bytes", bytes.size());
+struct Result {
+	std::size_t num_bytes = 0;
+	std::optional<std::pair<int, int>> blocking_byte;
+};
 
+Result solve(const std::vector<std::pair<int, int>> &bytes)
+{
 	auto map = get_map(71);
 
 	for (auto [x, y] : bytes) {
-		map[y + 1][x + 1] = '#';
+		map(x, y) = '#';
 	}
 
 	for (auto [x, y] : bytes | std::views::reverse) {
-		map[y + 1][x + 1] = '.';
+		map(x, y) = '.';
 
 		if (has_path(map)) {
-			std::println("{},{}", x, y);
-			break;
+			return {bytes.size(), std::pair(x, y)};
 		}
 	}
+
+	return {bytes.size(), std::nullopt};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "{} bytes", result.num_bytes);
+
+	if (result.blocking_byte) {
+		auto [x, y] = *result.blocking_byte;
+		std::println(out, "{},{}", x, y);
+	}
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -3,24 +3,26 @@
 //
 
 #include <algorithm>
-#include <iostream>
+#include <cstddef>
+#include <cstdio>
 #include <print>
 #include <ranges>
-#include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
-auto read_towels()
-{
-	using namespace std::literals;
+#include "input.h"
+#include "solver.h"
 
-	std::string line;
+namespace {
 
-	std::getline(std::cin, line);
+auto read_towels(aoc::Scanner &in)
+{
+	using namespace std::literals;
 
-	return line | std::views::split(", "sv) | std::views::transform(
+	return in.line() | std::views::split(", "sv) | std::views::transform(
 		[](const auto part) {
-			return std::string(part.data(), part.size());
+			return std::string_view(part.data(), part.size());
 		}
 	) | std::ranges::to<std::vector>();
 }
@@ -39,19 +41,52 @@ bool can_cover(const auto &towels, std::string_view design)
 	);
 }
 
-int main()
+struct Onsen {
+	std::vector<std::string_view> towels;
+	std::vector<std::string_view> designs;
+};
+
+struct Result {
+	std::size_t num_towels = 0;
+	int num_can_be_covered = 0;
+};
+
+Onsen parse(aoc::Scanner &in)
 {
-	auto towels = read_towels();
+	auto towels = read_towels(in);
+
+	std::vector<std::string_view> designs;
 
-	std::println("{} towels", towels.size());
+	for (std::string_view design; in.getline(design); ) {
+		if (!design.empty()) {
+			designs.push_back(design);
+		}
+	}
+
+	return {std::move(towels), std::move(designs)};
+}
+
+Result solve(const Onsen &onsen)
+{
+	const auto &towels = onsen.towels;
 
 	int num_can_be_covered = 0;
 
-	for (std::string design; std::getline(std::cin, design); ) {
-		if (!design.empty() && can_cover(towels, design)) {
+	for (auto design : onsen.designs) {
+		if (can_cover(towels, design)) {
 			++num_can_be_covered;
 		}
 	}
 
-	std::println("{} designs are possible", num_can_be_covered);
+	return {towels.size(), num_can_be_covered};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "{} towels", result.num_towels);
+	std::println(out, "{} designs are possible", result.num_can_be_covered);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
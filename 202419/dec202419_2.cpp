@@ -2,25 +2,27 @@
 // Advent of Code 2024, day 19, part two
 //
 
-#include <iostream>
+#include <cstddef>
+#include <cstdio>
 #include <print>
 #include <ranges>
-#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
-auto read_towels()
-{
-	using namespace std::literals;
+#include "input.h"
+#include "solver.h"
 
-	std::string line;
+namespace {
 
-	std::getline(std::cin, line);
+auto read_towels(aoc::Scanner &in)
+{
+	using namespace std::literals;
 
-	return line | std::views::split(", "sv) | std::views::transform(
+	return in.line() | std::views::split(", "sv) | std::views::transform(
 		[](const auto part) {
-			return std::string(part.data(), part.size());
+			return std::string_view(part.data(), part.size());
 		}
 	) | std::ranges::to<std::vector>();
 }
@@ -55,19 +57,50 @@ long ways_to_cover(const auto &towels, std::string_view design)
 	return ways_to_cover_recursive(towels, design, memory);
 }
 
-int main()
-{
-	auto towels = read_towels();
-
-	std::println("{} towels", towels.size());
+struct Onsen {
+	std::vector<std::string_view> towels;
+	std::vector<std::string_view> designs;
+};
 
+struct Result {
+	std::size_t num_towels = 0;
 	long total_ways_to_cover = 0;
+};
 
-	for (std::string design; std::getline(std::cin, design); ) {
+Onsen parse(aoc::Scanner &in)
+{
+	auto towels = read_towels(in);
+
+	std::vector<std::string_view> designs;
+
+	for (std::string_view design; in.getline(design); ) {
 		if (!design.empty()) {
-			total_ways_to_cover += ways_to_cover(towels, design);
+			designs.push_back(design);
 		}
 	}
 
-	std::println("{} ways to cover", total_ways_to_cover);
+	return {std::move(towels), std::move(designs)};
+}
+
+Result solve(const Onsen &onsen)
+{
+	const auto &towels = onsen.towels;
+
+	long total_ways_to_cover = 0;
+
+	for (auto design : onsen.designs) {
+		total_ways_to_cover += ways_to_cover(towels, design);
+	}
+
+	return {towels.size(), total_ways_to_cover};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "{} towels", result.num_towels);
+	std::println(out, "{} ways to cover", result.total_ways_to_cover);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -2,47 +2,21 @@
 // Advent of Code 2024, day 20, part one
 //
 
-#include <array>
-#include <cstddef>
-#include <functional>
-#include <iostream>
+#include <cstdio>
 #include <print>
 #include <queue>
-#include <ranges>
-#include <string>
 #include <tuple>
-#include <unordered_set>
-#include <utility>
-#include <vector>
-
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
-
-auto read_map()
-{
-	std::vector<std::string> map;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back(std::move(line));
-	}
+#include "coord_set.h"
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
 
-	return map;
-}
+namespace {
 
 int shortest_distance(const auto &map, int start_x, int start_y, int end_x, int end_y)
 {
-	constexpr std::array<std::array<int, 2>, 4> directions = {{
-		{ 0, 1 }, { -1, 0 }, { 0, -1 }, { 1, 0 }
-	}};
-
-	std::unordered_set<std::pair<int, int>, PairHash> seen;
+	aoc::CoordSet seen(map);
 
 	std::queue<std::tuple<int, int, int>> queue;
 
@@ -56,12 +30,12 @@ int shortest_distance(const auto &map, int start_x, int start_y, int end_x, int
 			return dist;
 		}
 
-		if (auto [it, success] = seen.insert({x, y}); !success) {
+		if (!seen.insert(x, y)) {
 			continue;
 		}
 
-		for (auto [dx, dy] : directions) {
-			if (map[y + dy][x + dx] != '#') {
+		for (auto [dx, dy] : aoc::directions4) {
+			if (map(x + dx, y + dy) != '#') {
 				queue.emplace(x + dx, y + dy, dist + 1);
 			}
 		}
@@ -70,41 +44,36 @@ int shortest_distance(const auto &map, int start_x, int start_y, int end_x, int
 	return -1;
 }
 
-auto get_coords_of(const auto &map, char ch) -> std::pair<int, int>
-{
-	for (const auto &[y, str] : std::views::enumerate(map)) {
-		if (auto x = str.find(ch); x != std::string::npos) {
-			return {x, y};
-		}
-	}
+struct Result {
+	int width = 0;
+	int height = 0;
+	int fastest_time = 0;
+	long num_saving_100 = 0;
+};
 
-	return {-1, -1};
+aoc::Grid<char> parse(aoc::Scanner &in)
+{
+	return aoc::read_grid(in);
 }
 
-int main()
+Result solve(aoc::Grid<char> map)
 {
-	auto map = read_map();
-
-	std::println("map {}x{}", map.front().size(), map.size());
-
-	auto [start_x, start_y] = get_coords_of(map, 'S');
-	auto [end_x, end_y] = get_coords_of(map, 'E');
+	auto [start_x, start_y] = map.coords(map.find('S'));
+	auto [end_x, end_y] = map.coords(map.find('E'));
 
 	auto fastest_time = shortest_distance(map, start_x, start_y, end_x, end_y);
 
-	std::println("fastest time {}", fastest_time);
-
 	long num_saving_100 = 0;
 
-	for (int y = 1; y + 1 < map.size(); ++y) {
-		for (int x = 1; x + 1 < map.front().size(); ++x) {
-			if (map[y][x] == '.') {
+	for (int y = 1; y + 1 < map.height(); ++y) {
+		for (int x = 1; x + 1 < map.width(); ++x) {
+			if (map(x, y) == '.') {
 				continue;
 			}
 
-			if ((map[y - 1][x] != '#' && map[y + 1][x] != '#')
-			 || (map[y][x - 1] != '#' && map[y][x + 1] != '#')) {
-				map[y][x] = '.';
+			if ((map(x, y - 1) != '#' && map(x, y + 1) != '#')
+			 || (map(x - 1, y) != '#' && map(x + 1, y) != '#')) {
+				map(x, y) = '.';
 
 				auto distance = shortest_distance(map, start_x, start_y, x, y)
 				              + shortest_distance(map, x, y, end_x, end_y);
@@ -113,10 +82,21 @@ int main()
 					++num_saving_100;
 				}
 
-				map[y][x] = '#';
+				map(x, y) = '#';
 			}
 		}
 	}
 
-	std::println("{} cheats save at least 100", num_saving_100);
+	return {map.width(), map.height(), fastest_time, num_saving_100};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "map {}x{}", result.width, result.height);
+	std::println(out, "fastest time {}", result.fastest_time);
+	std::println(out, "{} cheats save at least 100", result.num_saving_100);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -2,59 +2,23 @@
 // Advent of Code 2024, day 20, part two
 //
 
-#include <array>
-#include <cstddef>
+#include <cstdio>
 #include <cstdlib>
-#include <functional>
-#include <iostream>
 #include <print>
 #include <queue>
-#include <ranges>
-#include <string>
 #include <tuple>
-#include <unordered_map>
-#include <utility>
 #include <vector>
 
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
-
-auto read_map()
-{
-	std::vector<std::string> map;
+#include "grid.h"
+#include "input.h"
+#include "solver.h"
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		map.push_back(std::move(line));
-	}
-
-	return map;
-}
-
-auto get_coords_of(const auto &map, char ch) -> std::pair<int, int>
-{
-	for (const auto &[y, str] : std::views::enumerate(map)) {
-		if (auto x = str.find(ch); x != std::string::npos) {
-			return {x, y};
-		}
-	}
-
-	return {-1, -1};
-}
+namespace {
 
 auto create_distance_lookup(const auto &map, int start_x, int start_y)
 {
-	constexpr std::array<std::array<int, 2>, 4> directions = {{
-		{ 0, 1 }, { -1, 0 }, { 0, -1 }, { 1, 0 }
-	}};
-
-	std::unordered_map<std::pair<int, int>, int, PairHash> lookup;
+	// Distance from start to each position, or -1 if not reachable
+	aoc::Grid<int> lookup(map.width(), map.height(), 0, -1);
 
 	std::queue<std::tuple<int, int, int>> queue;
 
@@ -64,12 +28,14 @@ auto create_distance_lookup(const auto &map, int start_x, int start_y)
 		auto [x, y, dist] = queue.front();
 		queue.pop();
 
-		if (auto [it, success] = lookup.insert({{x, y}, dist}); !success) {
+		if (lookup(x, y) != -1) {
 			continue;
 		}
 
-		for (auto [dx, dy] : directions) {
-			if (map[y + dy][x + dx] != '#') {
+		lookup(x, y) = dist;
+
+		for (auto [dx, dy] : aoc::directions4) {
+			if (map(x + dx, y + dy) != '#') {
 				queue.emplace(x + dx, y + dy, dist + 1);
 			}
 		}
@@ -80,11 +46,6 @@ auto create_distance_lookup(const auto &map, int start_x, int start_y)
 
 auto get_reachable_within_distance(const auto &map, int x, int y, int max_dist)
 {
-	auto inside_map = [&](int x, int y) {
-		return x >= 0 && x < map.front().size()
-		    && y >= 0 && y < map.size();
-	};
-
 	std::vector<std::tuple<int, int, int>> reachable;
 
 	// Add all non-wall positions within taxicab distance max_dist
@@ -93,8 +54,8 @@ auto get_reachable_within_distance(const auto &map, int x, int y, int max_dist)
 			auto dist = std::abs(dx) + std::abs(dy);
 
 			if (dist > 1 && dist <= max_dist
-			 && inside_map(x + dx, y + dy)
-			 && map[y + dy][x + dx] != '#') {
+			 && map.contains(x + dx, y + dy)
+			 && map(x + dx, y + dy) != '#') {
 				reachable.emplace_back(x + dx, y + dy, dist);
 			}
 		}
@@ -103,39 +64,62 @@ auto get_reachable_within_distance(const auto &map, int x, int y, int max_dist)
 	return reachable;
 }
 
-int main()
-{
-	auto map = read_map();
+struct Result {
+	int width = 0;
+	int height = 0;
+	int fastest_time = 0;
+	long num_saving_100 = 0;
+};
 
-	std::println("map {}x{}", map.front().size(), map.size());
+aoc::Grid<char> parse(aoc::Scanner &in)
+{
+	return aoc::read_grid(in);
+}
 
-	auto [start_x, start_y] = get_coords_of(map, 'S');
-	auto [end_x, end_y] = get_coords_of(map, 'E');
+Result solve(const aoc::Grid<char> &map)
+{
+	auto [start_x, start_y] = map.coords(map.find('S'));
+	auto [end_x, end_y] = map.coords(map.find('E'));
 
 	auto dist_from_start = create_distance_lookup(map, start_x, start_y);
 	auto dist_to_end = create_distance_lookup(map, end_x, end_y);
 
-	auto fastest_time = dist_from_start[{end_x, end_y}];
-
-	std::println("fastest time {}", fastest_time);
+	auto fastest_time = dist_from_start(end_x, end_y);
 
 	long num_saving_100 = 0;
 
-	for (auto [pos, dist_to_pos] : dist_from_start) {
-		auto [x, y] = pos;
+	for (int y = 0; y < map.height(); ++y) {
+		for (int x = 0; x < map.width(); ++x) {
+			auto dist_to_pos = dist_from_start(x, y);
 
-		auto reachable = get_reachable_within_distance(map, x, y, 20);
+			if (dist_to_pos == -1) {
+				continue;
+			}
+
+			auto reachable = get_reachable_within_distance(map, x, y, 20);
 
-		for (auto [cheat_x, cheat_y, cheat_dist] : reachable) {
-			if (auto end_it = dist_to_end.find({cheat_x, cheat_y}); end_it != dist_to_end.end()) {
-				auto new_time = dist_to_pos + end_it->second + cheat_dist;
+			for (auto [cheat_x, cheat_y, cheat_dist] : reachable) {
+				if (auto dist_from_cheat = dist_to_end(cheat_x, cheat_y); dist_from_cheat != -1) {
+					auto new_time = dist_to_pos + dist_from_cheat + cheat_dist;
 
-				if (new_time + 100 <= fastest_time) {
-					++num_saving_100;
+					if (new_time + 100 <= fastest_time) {
+						++num_saving_100;
+					}
 				}
 			}
 		}
 	}
 
-	std::println("{} cheats save at least 100", num_saving_100);
+	return {map.width(), map.height(), fastest_time, num_saving_100};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "map {}x{}", result.width, result.height);
+	std::println(out, "fastest time {}", result.fastest_time);
+	std::println(out, "{} cheats save at least 100", result.num_saving_100);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
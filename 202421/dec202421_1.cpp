@@ -4,28 +4,23 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdio>
 #include <cstdlib>
 #include <functional>
-#include <iostream>
 #include <print>
 #include <queue>
 #include <ranges>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-auto read_codes()
-{
-	std::vector<std::string> codes;
+#include "input.h"
+#include "solver.h"
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		codes.push_back(std::move(line));
-	}
-
-	return codes;
-}
+namespace {
 
 constexpr auto taxicab_dist(int x1, int y1, int x2, int y2)
 {
@@ -252,15 +247,21 @@ auto get_moves_for_moves(const auto &in_moves)
 	return out_moves;
 }
 
-int main()
+struct Result {
+	std::vector<std::tuple<std::string_view, std::size_t, long>> codes;
+	long complexity_sum = 0;
+};
+
+std::vector<std::string_view> parse(aoc::Scanner &in)
 {
-	auto codes = read_codes();
+	return in.lines();
+}
 
-	long complexity_sum = 0;
+Result solve(const std::vector<std::string_view> &codes)
+{
+	Result result;
 
 	for (const auto &code : codes) {
-		std::println("---{}---", code);
-
 		auto moves = get_moves_for_moves(get_moves_for_moves(get_moves_for_code(code)));
 
 		auto min_length = std::ranges::min(moves | std::views::transform(
@@ -269,10 +270,26 @@ int main()
 			}
 		));
 
-		std::println("{} * {}", min_length, std::stol(code.substr(0, code.size() - 1)));
+		auto number = aoc::to_number(code);
+
+		result.codes.emplace_back(code, min_length, number);
 
-		complexity_sum += min_length * std::stol(code.substr(0, code.size() - 1));
+		result.complexity_sum += min_length * number;
 	}
 
-	std::println("complexity sum {}", complexity_sum);
+	return result;
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	for (auto [code, length, number] : result.codes) {
+		std::println(out, "---{}---", code);
+		std::println(out, "{} * {}", length, number);
+	}
+
+	std::println(out, "complexity sum {}", result.complexity_sum);
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -3,37 +3,22 @@
 //
 
 #include <algorithm>
-#include <cstddef>
+#include <cstdio>
 #include <cstdlib>
-#include <functional>
-#include <iostream>
 #include <print>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-struct PairHash {
-	template<typename T1, typename T2>
-	std::size_t operator()(const std::pair<T1, T2> &p) const noexcept
-	{
-		std::size_t h1 = std::hash<T1>()(p.first);
-		std::size_t h2 = std::hash<T2>()(p.second);
-		return (17 * 37 + h1) * 37 + h2;
-	}
-};
-
-auto read_codes()
-{
-	std::vector<std::string> codes;
+#include "flat_map.h"
+#include "input.h"
+#include "solver.h"
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		codes.push_back(std::move(line));
-	}
-
-	return codes;
-}
+namespace {
 
 auto get_numeric_moves(char from, char to)
 {
@@ -211,10 +196,10 @@ auto get_directional_moves(char from, char to)
 	return moves;
 }
 
-auto get_move_length_recursive(const std::string &in_move, int depth) -> long long
-{
-	static std::unordered_map<std::pair<std::string, int>, long long, PairHash> memory;
+using Memory = aoc::FlatMap<std::pair<std::string, int>, long long>;
 
+auto get_move_length_recursive(const std::string &in_move, int depth, Memory &memory) -> long long
+{
 	if (depth == 0) {
 		return std::ssize(in_move);
 	}
@@ -232,7 +217,7 @@ auto get_move_length_recursive(const std::string &in_move, int depth) -> long lo
 
 		auto min_cost = std::ranges::min(moves | std::views::transform(
 			[&](const auto &move) {
-				return get_move_length_recursive(move, depth - 1);
+				return get_move_length_recursive(move, depth - 1, memory);
 			}
 		));
 
@@ -246,20 +231,28 @@ auto get_move_length_recursive(const std::string &in_move, int depth) -> long lo
 	return length;
 }
 
-auto get_move_length(const std::string &move)
+auto get_move_length(const std::string &move, Memory &memory)
 {
-	return get_move_length_recursive(move, 25);
+	return get_move_length_recursive(move, 25, memory);
 }
 
-int main()
+struct Result {
+	std::vector<std::tuple<std::string_view, long long, long>> codes;
+	long long complexity_sum = 0;
+};
+
+std::vector<std::string_view> parse(aoc::Scanner &in)
 {
-	auto codes = read_codes();
+	return in.lines();
+}
 
-	long long complexity_sum = 0;
+Result solve(const std::vector<std::string_view> &codes)
+{
+	Memory memory;
 
-	for (const auto &code : codes) {
-		std::println("---{}---", code);
+	Result result;
 
+	for (const auto &code : codes) {
 		long long length = 0;
 
 		char from = 'A';
@@ -269,7 +262,7 @@ int main()
 
 			auto min_cost = std::ranges::min(moves | std::views::transform(
 				[&](const auto &move) {
-					return get_move_length(move);
+					return get_move_length(move, memory);
 				}
 			));
 
@@ -278,10 +271,26 @@ int main()
 			from = to;
 		}
 
-		std::println("{} * {}", length, std::stol(code.substr(0, code.size() - 1)));
+		auto number = aoc::to_number(code);
+
+		result.codes.emplace_back(code, length, number);
+
+		result.complexity_sum += length * number;
+	}
+
+	return result;
+}
 
-		complexity_sum += length * std::stol(code.substr(0, code.size() - 1));
+void print(std::FILE *out, const Result &result)
+{
+	for (auto [code, length, number] : result.codes) {
+		std::println(out, "---{}---", code);
+		std::println(out, "{} * {}", length, number);
 	}
 
-	std::println("complexity sum {}", complexity_sum);
+	std::println(out, "complexity sum {}", result.complexity_sum);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -4,17 +4,23 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdio>
 #include <functional>
-#include <iostream>
-#include <iterator>
 #include <print>
 #include <vector>
 
-int main()
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+std::vector<std::uint32_t> parse(aoc::Scanner &in)
 {
-	std::vector<std::uint32_t> secrets(std::istream_iterator<std::uint32_t>{std::cin},
-	                                   std::istream_iterator<std::uint32_t>{});
+	return aoc::numbers<std::uint32_t>(in.remaining());
+}
 
+unsigned long long solve(std::vector<std::uint32_t> secrets)
+{
 	for (auto &secret : secrets) {
 		for (int round = 0; round < 2000; ++round) {
 			secret = secret ^ (secret << 6);
@@ -26,7 +32,14 @@ int main()
 		}
 	}
 
-	auto sum = std::ranges::fold_left(secrets, 0ULL, std::plus{});
+	return std::ranges::fold_left(secrets, 0ULL, std::plus{});
+}
 
-	std::println("sum is {}", sum);
+void print(std::FILE *out, unsigned long long sum)
+{
+	std::println(out, "sum is {}", sum);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -4,42 +4,30 @@
 
 #include <algorithm>
 #include <array>
-#include <cstddef>
 #include <cstdint>
-#include <iostream>
-#include <iterator>
+#include <cstdio>
 #include <print>
 #include <ranges>
-#include <tuple>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-struct TupleHash {
-	template<typename... Ts>
-	std::size_t operator()(const std::tuple<Ts...> &tuple) const noexcept
-	{
-		std::size_t hash = 17;
-		std::apply([&hash](const auto &... args) {
-			(..., (hash = hash * 37 + std::hash<Ts>()(args)));
-		}, tuple);
-		return hash;
-	}
-};
+#include "flat_map.h"
+#include "input.h"
+#include "solver.h"
+
+namespace {
 
-int main()
+std::vector<std::uint32_t> parse(aoc::Scanner &in)
 {
-	std::vector<std::uint32_t> secrets(std::istream_iterator<std::uint32_t>{std::cin},
-	                                   std::istream_iterator<std::uint32_t>{});
+	return aoc::numbers<std::uint32_t>(in.remaining());
+}
 
+long solve(const std::vector<std::uint32_t> &secrets)
+{
 	// For each tuple of 4 changes, we store the sum of bananas it will
 	// give. To avoid duplicates, we store the initial secret of the last
 	// monkey that added to the sum as an id.
-	std::unordered_map<
-		std::tuple<std::int8_t, std::int8_t, std::int8_t, std::int8_t>,
-	        std::pair<std::uint32_t, long>,
-		TupleHash
-	> bananas;
+	aoc::FlatMap<std::array<std::int8_t, 4>, std::pair<std::uint32_t, long>> bananas;
 
 	for (const auto initial_secret : secrets) {
 		std::array<std::int8_t, 4> changes = {};
@@ -75,7 +63,14 @@ int main()
 		}
 	}
 
-	long max_bananas = std::ranges::max(bananas | std::views::values | std::views::elements<1>);
+	return std::ranges::max(bananas | std::views::values | std::views::elements<1>);
+}
 
-	std::println("max bananas {}", max_bananas);
+void print(std::FILE *out, long max_bananas)
+{
+	std::println(out, "max bananas {}", max_bananas);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
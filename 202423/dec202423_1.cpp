@@ -5,36 +5,29 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
-#include <iostream>
+#include <cstdio>
 #include <print>
 #include <ranges>
 #include <string>
-#include <tuple>
+#include <string_view>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
-struct TupleHash {
-	template<typename... Ts>
-	std::size_t operator()(const std::tuple<Ts...> &tuple) const noexcept
-	{
-		std::size_t hash = 17;
-		std::apply([&hash](const auto &... args) {
-			(..., (hash = hash * 37 + std::hash<Ts>()(args)));
-		}, tuple);
-		return hash;
-	}
-};
+#include "flat_map.h"
+#include "input.h"
+#include "solver.h"
+
+namespace {
 
 using Graph = std::unordered_map<std::string, std::vector<std::string>>;
 
-auto read_graph()
+Graph parse(aoc::Scanner &in)
 {
 	Graph adj;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::string lhs = line.substr(0, 2);
-		std::string rhs = line.substr(3);
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
+		std::string lhs(line.substr(0, 2));
+		std::string rhs(line.substr(3));
 
 		adj[lhs].push_back(rhs);
 		adj[rhs].push_back(lhs);
@@ -43,13 +36,14 @@ auto read_graph()
 	return adj;
 }
 
-int main()
-{
-	auto adj = read_graph();
-
-	std::println("network of {} computers", adj.size());
+struct Result {
+	std::size_t num_computers = 0;
+	std::ptrdiff_t num_triangles_with_t = 0;
+};
 
-	std::unordered_set<std::tuple<std::string, std::string, std::string>, TupleHash> triangles;
+Result solve(const Graph &adj)
+{
+	aoc::FlatSet<std::array<std::string, 3>> triangles;
 
 	// Brute force all chains of 3 computers, storing
 	// them in a set to remove duplicates
@@ -70,5 +64,15 @@ int main()
 		return a.starts_with('t') || b.starts_with('t') || c.starts_with('t');
 	};
 
-	std::println("{} triangles with t", std::ranges::count_if(triangles, one_starts_with_t));
+	return {adj.size(), std::ranges::count_if(triangles, one_starts_with_t)};
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "network of {} computers", result.num_computers);
+	std::println(out, "{} triangles with t", result.num_triangles_with_t);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -5,37 +5,30 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
-#include <iostream>
-#include <iterator>
+#include <cstdio>
 #include <print>
 #include <ranges>
 #include <string>
-#include <tuple>
+#include <string_view>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
-struct TupleHash {
-	template<typename... Ts>
-	std::size_t operator()(const std::tuple<Ts...> &tuple) const noexcept
-	{
-		std::size_t hash = 17;
-		std::apply([&hash](const auto &... args) {
-			(..., (hash = hash * 37 + std::hash<Ts>()(args)));
-		}, tuple);
-		return hash;
-	}
-};
+#include "flat_map.h"
+#include "input.h"
+#include "solver.h"
+
+namespace {
 
 using Graph = std::unordered_map<std::string, std::vector<std::string>>;
 
-auto read_graph()
+Graph parse(aoc::Scanner &in)
 {
 	Graph adj;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::string lhs = line.substr(0, 2);
-		std::string rhs = line.substr(3);
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
+		std::string lhs(line.substr(0, 2));
+		std::string rhs(line.substr(3));
 
 		adj[lhs].push_back(rhs);
 		adj[rhs].push_back(lhs);
@@ -46,7 +39,7 @@ auto read_graph()
 
 auto get_triangles(const Graph &adj)
 {
-	std::unordered_set<std::tuple<std::string, std::string, std::string>, TupleHash> triangles;
+	aoc::FlatSet<std::array<std::string, 3>> triangles;
 
 	// Brute force all chains of 3 computers, storing
 	// them in a set to remove duplicates
@@ -65,12 +58,13 @@ auto get_triangles(const Graph &adj)
 	return triangles;
 }
 
-int main()
-{
-	auto adj = read_graph();
-
-	std::println("network of {} computers", adj.size());
+struct Result {
+	std::size_t num_computers = 0;
+	std::vector<std::string> maximum_clique;
+};
 
+Result solve(const Graph &adj)
+{
 	// Use the triangles as basis for cliques
 	auto triangles = get_triangles(adj);
 
@@ -102,6 +96,20 @@ int main()
 
 	std::ranges::sort(maximum_clique);
 
-	std::ranges::copy(maximum_clique, std::ostream_iterator<std::string>(std::cout, ","));
-	std::cout << '\n';
+	return {adj.size(), std::move(maximum_clique)};
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "network of {} computers", result.num_computers);
+
+	for (const auto &node : result.maximum_clique) {
+		std::print(out, "{},", node);
+	}
+
+	std::println(out, "");
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -2,8 +2,9 @@
 // Advent of Code 2024, day 24, part one
 //
 
+#include <cstddef>
 #include <cstdint>
-#include <iostream>
+#include <cstdio>
 #include <optional>
 #include <print>
 #include <ranges>
@@ -13,6 +14,11 @@
 #include <utility>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
 auto split(std::string_view sv, std::string_view delim)
 {
 	return sv | std::views::split(delim) | std::views::transform(
@@ -36,23 +42,23 @@ struct Gate {
 	std::optional<unsigned int> out_val;
 };
 
-auto read_inputs()
+auto read_inputs(aoc::Scanner &in)
 {
 	std::unordered_map<std::string, unsigned int> inputs;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
-		std::string name = line.substr(0, line.find(':'));
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
+		std::string name(line.substr(0, line.find(':')));
 		inputs.emplace(std::move(name), line.back() - '0');
 	}
 
 	return inputs;
 }
 
-auto read_gates()
+auto read_gates(aoc::Scanner &in)
 {
 	std::vector<Gate> gates;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
 		auto parts = split(line, " ");
 
 		std::string lhs(parts[0]);
@@ -117,15 +123,30 @@ bool update_gates_and_input(auto &gates, auto &inputs)
 	return progress;
 }
 
-int main()
+struct Circuit {
+	std::unordered_map<std::string, unsigned int> inputs;
+	std::vector<Gate> gates;
+};
+
+struct Result {
+	std::size_t num_inputs = 0;
+	std::size_t num_gates = 0;
+	std::uint64_t output = 0;
+};
+
+Circuit parse(aoc::Scanner &in)
 {
-	auto inputs = read_inputs();
+	auto inputs = read_inputs(in);
+	auto gates = read_gates(in);
 
-	std::println("{} inputs", inputs.size());
+	return {std::move(inputs), std::move(gates)};
+}
 
-	auto gates = read_gates();
+Result solve(Circuit circuit)
+{
+	auto &[inputs, gates] = circuit;
 
-	std::println("{} gates", gates.size());
+	Result result = {inputs.size(), gates.size()};
 
 	for (;;) {
 		if (!update_gates_and_input(gates, inputs)) {
@@ -133,14 +154,23 @@ int main()
 		}
 	}
 
-	std::uint64_t result = 0;
-
 	for (const auto &[name, value] : inputs) {
 		if (name.starts_with('z') && value != 0) {
 			auto index = std::stol(name.substr(1));
-			result |= std::uint64_t{1} << index;
+			result.output |= std::uint64_t{1} << index;
 		}
 	}
 
-	std::println("output: {}", result);
+	return result;
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "{} inputs", result.num_inputs);
+	std::println(out, "{} gates", result.num_gates);
+	std::println(out, "output: {}", result.output);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -5,10 +5,10 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <format>
-#include <iostream>
-#include <iterator>
 #include <optional>
 #include <print>
 #include <random>
@@ -19,6 +19,11 @@
 #include <utility>
 #include <vector>
 
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
 auto split(std::string_view sv, std::string_view delim)
 {
 	return sv | std::views::split(delim) | std::views::transform(
@@ -42,11 +47,11 @@ struct Gate {
 	std::optional<unsigned int> out_val;
 };
 
-auto read_gates()
+auto read_gates(aoc::Scanner &in)
 {
 	std::vector<Gate> gates;
 
-	for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
+	for (std::string_view line; in.getline(line) && !line.empty(); ) {
 		auto parts = split(line, " ");
 
 		std::string lhs(parts[0]);
@@ -200,45 +205,57 @@ auto check_gates(const auto &gates)
 	return true;
 }
 
-auto check_swaps(auto &gates, auto a, auto b, auto c, auto d)
+auto check_swaps(auto &gates, auto a, auto b, auto c, auto d) -> std::optional<std::array<std::string, 8>>
 {
+	std::optional<std::array<std::string, 8>> result;
+
 	std::swap(gates[a.first].out, gates[a.second].out);
 	std::swap(gates[b.first].out, gates[b.second].out);
 	std::swap(gates[c.first].out, gates[c.second].out);
 	std::swap(gates[d.first].out, gates[d.second].out);
 
 	if (check_gates(gates)) {
-		std::array<std::string, 8> result = {
+		result = {
 			gates[a.first].out, gates[a.second].out,
 			gates[b.first].out, gates[b.second].out,
 			gates[c.first].out, gates[c.second].out,
 			gates[d.first].out, gates[d.second].out
 		};
 
-		std::ranges::sort(result);
-
-		std::ranges::copy(result, std::ostream_iterator<std::string>(std::cout, ","));
-		std::cout << '\n';
+		std::ranges::sort(*result);
 	}
 
 	std::swap(gates[d.first].out, gates[d.second].out);
 	std::swap(gates[c.first].out, gates[c.second].out);
 	std::swap(gates[b.first].out, gates[b.second].out);
 	std::swap(gates[a.first].out, gates[a.second].out);
+
+	return result;
 }
 
-int main()
+struct Result {
+	std::size_t num_gates = 0;
+	std::size_t num_swaps = 0;
+	std::vector<std::array<std::string, 8>> solutions;
+};
+
+std::vector<Gate> parse(aoc::Scanner &in)
 {
 	// Skip input values
-	for (std::string line; std::getline(std::cin, line); ) {
+	for (std::string_view line; in.getline(line); ) {
 		if (line.empty()) {
 			break;
 		}
 	}
 
-	auto gates = read_gates();
+	return read_gates(in);
+}
+
+Result solve(std::vector<Gate> gates)
+{
+	Result result;
 
-	std::println("{} gates", gates.size());
+	result.num_gates = gates.size();
 
 	auto swaps = get_possible_swaps(gates);
 
@@ -256,16 +273,38 @@ int main()
 
 	swaps.erase(res.begin(), res.end());
 
-	std::println("{} possible swaps found", swaps.size());
+	result.num_swaps = swaps.size();
 
 	// Try all combinations of 4 unique swaps
 	for (int i = 0; i < std::ssize(swaps); ++i) {
 		for (int j = i + 1; j < std::ssize(swaps); ++j) {
 			for (int k = j + 1; k < std::ssize(swaps); ++k) {
 				for (int l = k + 1; l < std::ssize(swaps); ++l) {
-					check_swaps(gates, swaps[i], swaps[j], swaps[k], swaps[l]);
+					if (auto wires = check_swaps(gates, swaps[i], swaps[j], swaps[k], swaps[l])) {
+						result.solutions.push_back(std::move(*wires));
+					}
 				}
 			}
 		}
 	}
+
+	return result;
 }
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "{} gates", result.num_gates);
+	std::println(out, "{} possible swaps found", result.num_swaps);
+
+	for (const auto &wires : result.solutions) {
+		for (const auto &wire : wires) {
+			std::print(out, "{},", wire);
+		}
+
+		std::println(out, "");
+	}
+}
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
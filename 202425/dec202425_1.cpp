@@ -4,23 +4,36 @@
 
 #include <algorithm>
 #include <array>
-#include <iostream>
+#include <cstddef>
+#include <cstdio>
 #include <print>
 #include <ranges>
-#include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
 
-auto read_locks_and_keys()
+#include "input.h"
+#include "solver.h"
+
+namespace {
+
+using Pins = std::tuple<int, int, int, int, int>;
+
+struct Schematics {
+	std::vector<Pins> locks;
+	std::vector<Pins> keys;
+};
+
+Schematics parse(aoc::Scanner &in)
 {
-	std::vector<std::tuple<int, int, int, int, int>> locks;
-	std::vector<std::tuple<int, int, int, int, int>> keys;
+	std::vector<Pins> locks;
+	std::vector<Pins> keys;
 
-	for (std::string first_line; std::getline(std::cin, first_line); ) {
+	for (std::string_view first_line; in.getline(first_line); ) {
 		std::array<int, 5> pins = {};
 
-		for (std::string line; std::getline(std::cin, line) && !line.empty(); ) {
+		for (std::string_view line; in.getline(line) && !line.empty(); ) {
 			for (auto [idx, ch] : std::views::enumerate(line)) {
 				pins[idx] += (ch == '#');
 			}
@@ -40,14 +53,18 @@ auto read_locks_and_keys()
 
 	}
 
-	return std::make_pair(locks, keys);
+	return {std::move(locks), std::move(keys)};
 }
 
-int main()
-{
-	auto [locks, keys] = read_locks_and_keys();
+struct Result {
+	std::size_t num_locks = 0;
+	std::size_t num_keys = 0;
+	int num_matching = 0;
+};
 
-	std::println("{} locks, {} keys", locks.size(), keys.size());
+Result solve(const Schematics &schematics)
+{
+	const auto &[locks, keys] = schematics;
 
 	auto matches = [](const auto &key, const auto &lock) {
 		return std::get<0>(key) <= 5 - std::get<0>(lock)
@@ -63,5 +80,15 @@ int main()
 		num_matching += matches(key, lock);
 	}
 
-	std::println("{} matching keys", num_matching);
+	return {locks.size(), keys.size(), num_matching};
+}
+
+void print(std::FILE *out, const Result &result)
+{
+	std::println(out, "{} locks, {} keys", result.num_locks, result.num_keys);
+	std::println(out, "{} matching keys", result.num_matching);
 }
+
+} // namespace
+
+AOC_SOLVER(parse, solve, print)
@@ -0,0 +1,115 @@
+//
+// Advent of Code 2024, heap allocation counting
+//
+// Replaces the global operator new and delete. This is kept in its own
+// translation unit so the compiler does not inline the replacements into
+// library code and then warn about mismatched malloc and delete.
+//
+// Each block starts with a header holding its size, so unsized delete can
+// keep track of the bytes still allocated.
+//
+// The counters are shared by all threads, so allocations made by the
+// worker threads of a solver are included.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if __has_include(<sys/resource.h>)
+#  include <sys/resource.h>
+#  define AOC_HAVE_GETRUSAGE 1
+#endif
+
+#include "alloc_count.h"
+
+namespace {
+
+// Keeps the memory returned suitably aligned
+constexpr std::size_t header_size = alignof(std::max_align_t);
+
+std::atomic<std::size_t> num_allocations = 0;
+std::atomic<std::size_t> num_bytes = 0;
+std::atomic<std::ptrdiff_t> live_bytes = 0;
+std::atomic<std::ptrdiff_t> peak_bytes = 0;
+
+} // namespace
+
+// The array and nothrow forms forward to this one
+void *operator new(std::size_t size)
+{
+	num_allocations.fetch_add(1, std::memory_order_relaxed);
+	num_bytes.fetch_add(size, std::memory_order_relaxed);
+
+	auto live = live_bytes.fetch_add(size, std::memory_order_relaxed) + static_cast<std::ptrdiff_t>(size);
+
+	for (auto peak = peak_bytes.load(std::memory_order_relaxed); peak < live; ) {
+		if (peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+			break;
+		}
+	}
+
+	if (auto *block = static_cast<char *>(std::malloc(size + header_size))) {
+		std::memcpy(block, &size, sizeof(size));
+		return block + header_size;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	if (p == nullptr) {
+		return;
+	}
+
+	auto *block = static_cast<char *>(p) - header_size;
+
+	std::size_t size = 0;
+
+	std::memcpy(&size, block, sizeof(size));
+
+	live_bytes.fetch_sub(size, std::memory_order_relaxed);
+
+	std::free(block);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	operator delete(p);
+}
+
+aoc::AllocCount aoc::alloc_count()
+{
+	return {
+		num_allocations.load(std::memory_order_relaxed),
+		num_bytes.load(std::memory_order_relaxed),
+		live_bytes.load(std::memory_order_relaxed),
+		peak_bytes.load(std::memory_order_relaxed)
+	};
+}
+
+void aoc::reset_alloc_peak()
+{
+	peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+std::size_t aoc::peak_rss()
+{
+#ifdef AOC_HAVE_GETRUSAGE
+	struct rusage usage = {};
+
+	if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+#  ifdef __APPLE__
+		return usage.ru_maxrss;
+#  else
+		return usage.ru_maxrss * std::size_t{1024};
+#  endif
+	}
+#endif
+
+	return 0;
+}
@@ -0,0 +1,41 @@
+//
+// Advent of Code 2024, heap allocation counting
+//
+// alloc_count.cpp replaces the global operator new and delete with versions
+// that count the allocations made by the process. It is linked into the
+// benchmarks, and into all programs when building with
+// AOC_TRACK_ALLOCATIONS, which makes PhaseTimer record the allocations of
+// each phase.
+//
+
+#ifndef AOC_ALLOC_COUNT_H_INCLUDED
+#define AOC_ALLOC_COUNT_H_INCLUDED
+
+#include <cstddef>
+
+namespace aoc {
+
+struct AllocCount {
+	std::size_t allocations = 0;
+	std::size_t bytes = 0;
+	std::ptrdiff_t live_bytes = 0;
+	std::ptrdiff_t peak_bytes = 0;
+};
+
+// Allocations made through operator new by all threads since the program
+// started, the bytes still allocated, and the most allocated at one time
+// since the last reset_alloc_peak()
+//
+// Counting the whole process includes the threads a solver starts, but
+// also anything else running at the same time.
+AllocCount alloc_count();
+
+// Restart the peak from the bytes currently allocated
+void reset_alloc_peak();
+
+// Highest resident memory of the process so far in bytes, or 0 if unknown
+std::size_t peak_rss();
+
+} // namespace aoc
+
+#endif // AOC_ALLOC_COUNT_H_INCLUDED
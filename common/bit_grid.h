@@ -0,0 +1,155 @@
+//
+// Advent of Code 2024, grid of bits
+//
+// BitGrid stores one bit per cell, packed row by row into 64-bit words, so
+// a single operation on words works on 64 cells at once. Each row starts on
+// a new word, and the bits past the width of the map are always zero.
+//
+// word(y, w, shift) reads the bits of a row moved by shift cells, so a
+// pattern of cells can be matched by combining the shifted words of the
+// rows it covers with bitwise operations.
+//
+// letter_planes() turns lines of text into one bit grid per letter, where
+// the cells holding that letter are set. Like read_grid(), it throws
+// InputError for lines of different lengths.
+//
+
+#ifndef AOC_BIT_GRID_H_INCLUDED
+#define AOC_BIT_GRID_H_INCLUDED
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#include "input.h"
+
+namespace aoc {
+
+class BitGrid {
+public:
+	BitGrid() = default;
+
+	BitGrid(int width, int height)
+		: width_(width), height_(height),
+		  words_per_row_((static_cast<std::size_t>(width) + 63) / 64),
+		  words_(words_per_row_ * height) {}
+
+	int width() const { return width_; }
+	int height() const { return height_; }
+	std::size_t words_per_row() const { return words_per_row_; }
+
+	bool test(int x, int y) const
+	{
+		return (row(y)[x / 64] >> (x % 64)) & 1;
+	}
+
+	void set(int x, int y)
+	{
+		row(y)[x / 64] |= std::uint64_t{1} << (x % 64);
+	}
+
+	// Words of row y, bit i of word w is the cell at x = 64 * w + i
+	std::span<std::uint64_t> row(int y)
+	{
+		return {&words_[static_cast<std::size_t>(y) * words_per_row_], words_per_row_};
+	}
+
+	std::span<const std::uint64_t> row(int y) const
+	{
+		return {&words_[static_cast<std::size_t>(y) * words_per_row_], words_per_row_};
+	}
+
+	// Word w of row y moved so bit i is the cell at x = 64 * w + i + shift,
+	// where shift is -63 to 63. Cells outside the map read as zero.
+	std::uint64_t word(int y, std::size_t w, int shift) const
+	{
+		auto bits = row(y);
+
+		if (shift > 0) {
+			auto next = w + 1 < bits.size() ? bits[w + 1] : 0;
+
+			return (bits[w] >> shift) | (next << (64 - shift));
+		}
+
+		if (shift < 0) {
+			auto prev = w > 0 ? bits[w - 1] : 0;
+
+			return (bits[w] << -shift) | (prev >> (64 + shift));
+		}
+
+		return bits[w];
+	}
+
+	// Number of cells set
+	std::size_t count() const
+	{
+		std::size_t res = 0;
+
+		for (auto word : words_) {
+			res += std::popcount(word);
+		}
+
+		return res;
+	}
+
+private:
+	int width_ = 0;
+	int height_ = 0;
+	std::size_t words_per_row_ = 0;
+	std::vector<std::uint64_t> words_;
+};
+
+// One bit grid for each of letters, with the cells of lines holding that
+// letter set. All lines must have the same length.
+inline std::vector<BitGrid> letter_planes(std::span<const std::string_view> lines, std::string_view letters)
+{
+	const int height = static_cast<int>(lines.size());
+	const int width = lines.empty() ? 0 : static_cast<int>(lines.front().size());
+
+	std::vector<BitGrid> planes(letters.size(), BitGrid(width, height));
+
+	for (int y = 0; y < height; ++y) {
+		auto line = lines[y];
+
+		if (static_cast<int>(line.size()) != width) {
+			throw InputError(std::format("line {} of the grid has length {}, expected {}",
+			                             y + 1, line.size(), width));
+		}
+
+		std::size_t x = 0;
+
+#if defined(__SSE2__)
+		// Compare 16 cells at a time, x is a multiple of 16 so the mask
+		// never straddles two words
+		for (; x + 16 <= line.size(); x += 16) {
+			auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(line.data() + x));
+
+			for (std::size_t i = 0; i < letters.size(); ++i) {
+				auto mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8(letters[i])));
+
+				planes[i].row(y)[x / 64] |= static_cast<std::uint64_t>(mask) << (x % 64);
+			}
+		}
+#endif
+
+		for (; x < line.size(); ++x) {
+			if (auto i = letters.find(line[x]); i != std::string_view::npos) {
+				planes[i].set(static_cast<int>(x), y);
+			}
+		}
+	}
+
+	return planes;
+}
+
+} // namespace aoc
+
+#endif // AOC_BIT_GRID_H_INCLUDED
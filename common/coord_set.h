@@ -0,0 +1,196 @@
+//
+// Advent of Code 2024, dense set of grid coordinates
+//
+// CoordSet is a set of (x, y) positions within known bounds, stored as one
+// bit per position. It uses the same coordinates as Grid<T>, including any
+// padding, so it can be sized directly from the grid it is used with.
+//
+// For mapping positions within known bounds to values, use a Grid<V> of
+// the same size. For keys without known bounds, use FlatMap/FlatSet from
+// flat_map.h.
+//
+
+#ifndef AOC_COORD_SET_H_INCLUDED
+#define AOC_COORD_SET_H_INCLUDED
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "grid.h"
+
+namespace aoc {
+
+class CoordSet {
+public:
+	// Iterates over the positions in the set in row-major order
+	class Iterator {
+	public:
+		using value_type = std::pair<int, int>;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::pair<int, int>;
+		using iterator_category = std::input_iterator_tag;
+		using iterator_concept = std::forward_iterator_tag;
+
+		Iterator() = default;
+
+		Iterator(const CoordSet *set, std::size_t pos) : set(set), pos(pos)
+		{
+			skip_unset();
+		}
+
+		std::pair<int, int> operator*() const { return set->coords(pos); }
+
+		Iterator &operator++()
+		{
+			++pos;
+			skip_unset();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const Iterator &other) const { return pos == other.pos; }
+
+	private:
+		// Move pos to the next set bit, or to the end
+		void skip_unset()
+		{
+			const auto &bits = set->bits;
+
+			std::size_t word = pos / 64;
+
+			if (word >= bits.size()) {
+				pos = set->num_positions;
+				return;
+			}
+
+			std::uint64_t cur = bits[word] & (~std::uint64_t{0} << (pos % 64));
+
+			while (cur == 0) {
+				if (++word == bits.size()) {
+					pos = set->num_positions;
+					return;
+				}
+
+				cur = bits[word];
+			}
+
+			pos = word * 64 + std::countr_zero(cur);
+		}
+
+		const CoordSet *set = nullptr;
+		std::size_t pos = 0;
+	};
+
+	using iterator = Iterator;
+	using const_iterator = Iterator;
+	using value_type = std::pair<int, int>;
+
+	CoordSet() = default;
+
+	CoordSet(int width, int height, int padding = 0)
+		: width(width), height(height), padding(padding), stride(width + 2 * padding),
+		  num_positions(static_cast<std::size_t>(stride) * (height + 2 * padding)),
+		  bits((num_positions + 63) / 64, 0) {}
+
+	// Set covering all positions of grid, including padding
+	template<typename T>
+	explicit CoordSet(const Grid<T> &grid)
+		: CoordSet(grid.width(), grid.height(), grid.padding()) {}
+
+	// Returns true if (x, y) was not already in the set
+	bool insert(int x, int y)
+	{
+		auto pos = position(x, y);
+		auto mask = std::uint64_t{1} << (pos % 64);
+
+		if (bits[pos / 64] & mask) {
+			return false;
+		}
+
+		bits[pos / 64] |= mask;
+		++count;
+
+		return true;
+	}
+
+	bool insert(std::pair<int, int> p) { return insert(p.first, p.second); }
+
+	// Returns true if (x, y) was in the set
+	bool erase(int x, int y)
+	{
+		auto pos = position(x, y);
+		auto mask = std::uint64_t{1} << (pos % 64);
+
+		if (!(bits[pos / 64] & mask)) {
+			return false;
+		}
+
+		bits[pos / 64] &= ~mask;
+		--count;
+
+		return true;
+	}
+
+	bool erase(std::pair<int, int> p) { return erase(p.first, p.second); }
+
+	// Positions outside the bounds are never in the set
+	bool contains(int x, int y) const
+	{
+		if (x < -padding || x >= width + padding || y < -padding || y >= height + padding) {
+			return false;
+		}
+
+		auto pos = position(x, y);
+
+		return (bits[pos / 64] >> (pos % 64)) & 1;
+	}
+
+	bool contains(std::pair<int, int> p) const { return contains(p.first, p.second); }
+
+	std::size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	void clear()
+	{
+		std::ranges::fill(bits, 0);
+		count = 0;
+	}
+
+	Iterator begin() const { return {this, 0}; }
+	Iterator end() const { return {this, num_positions}; }
+
+private:
+	std::size_t position(int x, int y) const
+	{
+		return static_cast<std::size_t>(y + padding) * stride + (x + padding);
+	}
+
+	std::pair<int, int> coords(std::size_t pos) const
+	{
+		return {static_cast<int>(pos % stride) - padding,
+		        static_cast<int>(pos / stride) - padding};
+	}
+
+	int width = 0;
+	int height = 0;
+	int padding = 0;
+	int stride = 0;
+	std::size_t num_positions = 0;
+	std::vector<std::uint64_t> bits;
+	std::size_t count = 0;
+};
+
+} // namespace aoc
+
+#endif // AOC_COORD_SET_H_INCLUDED
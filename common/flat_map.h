@@ -0,0 +1,279 @@
+//
+// Advent of Code 2024, open-addressing hash map and set
+//
+// FlatMap and FlatSet keep all entries in one array and resolve collisions
+// by linear probing, so a lookup is usually a single cache miss instead of
+// chasing the node and bucket pointers of std::unordered_map.
+//
+// They support the subset of the std::unordered_map/set interface the
+// solvers use. There is no erase, and unlike the node based containers,
+// any insertion may invalidate iterators and references.
+//
+
+#ifndef AOC_FLAT_MAP_H_INCLUDED
+#define AOC_FLAT_MAP_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "hash.h"
+
+namespace aoc {
+
+namespace detail {
+
+// Table of Slot, where key_of(slot) gives the key of a slot
+template<typename Slot, typename Key, typename KeyOf, typename H, typename Eq>
+class FlatTable {
+public:
+	template<bool Const>
+	class Iterator {
+	public:
+		using value_type = Slot;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<Const, const Slot &, Slot &>;
+		using pointer = std::conditional_t<Const, const Slot *, Slot *>;
+		using iterator_category = std::forward_iterator_tag;
+
+		using table_type = std::conditional_t<Const, const FlatTable, FlatTable>;
+
+		Iterator() = default;
+
+		Iterator(table_type *table, std::size_t pos) : table(table), pos(pos)
+		{
+			skip_unused();
+		}
+
+		operator Iterator<true>() const { return {table, pos}; }
+
+		reference operator*() const { return table->slots[pos]; }
+		pointer operator->() const { return &table->slots[pos]; }
+
+		Iterator &operator++()
+		{
+			++pos;
+			skip_unused();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const Iterator &other) const { return pos == other.pos; }
+
+	private:
+		void skip_unused()
+		{
+			while (pos < table->used.size() && !table->used[pos]) {
+				++pos;
+			}
+		}
+
+		table_type *table = nullptr;
+		std::size_t pos = 0;
+	};
+
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	FlatTable() = default;
+
+	explicit FlatTable(std::size_t capacity) { reserve(capacity); }
+
+	std::size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	iterator begin() { return {this, 0}; }
+	iterator end() { return {this, used.size()}; }
+	const_iterator begin() const { return {this, 0}; }
+	const_iterator end() const { return {this, used.size()}; }
+
+	iterator find(const Key &key)
+	{
+		if (count == 0) {
+			return end();
+		}
+
+		auto pos = probe(key);
+
+		return used[pos] ? iterator{this, pos} : end();
+	}
+
+	const_iterator find(const Key &key) const
+	{
+		if (count == 0) {
+			return end();
+		}
+
+		auto pos = probe(key);
+
+		return used[pos] ? const_iterator{this, pos} : end();
+	}
+
+	bool contains(const Key &key) const { return find(key) != end(); }
+
+	// Make room for n entries without rehashing
+	void reserve(std::size_t n)
+	{
+		std::size_t capacity = 16;
+
+		while (capacity - capacity / 4 < n) {
+			capacity *= 2;
+		}
+
+		if (capacity > slots.size()) {
+			rehash(capacity);
+		}
+	}
+
+	void clear()
+	{
+		for (std::size_t i = 0; i < used.size(); ++i) {
+			if (used[i]) {
+				slots[i] = Slot{};
+				used[i] = 0;
+			}
+		}
+
+		count = 0;
+	}
+
+protected:
+	// Insert slot made by make_slot() if key is not present
+	template<typename MakeSlot>
+	std::pair<iterator, bool> insert_with(const Key &key, MakeSlot make_slot)
+	{
+		if (count + 1 > slots.size() - slots.size() / 4) {
+			rehash(slots.empty() ? 16 : 2 * slots.size());
+		}
+
+		auto pos = probe(key);
+
+		if (used[pos]) {
+			return {iterator{this, pos}, false};
+		}
+
+		slots[pos] = make_slot();
+		used[pos] = 1;
+		++count;
+
+		return {iterator{this, pos}, true};
+	}
+
+private:
+	// Position of key, or of the empty slot where it would be inserted
+	std::size_t probe(const Key &key) const
+	{
+		const std::size_t mask = slots.size() - 1;
+
+		for (std::size_t pos = H()(key) & mask; ; pos = (pos + 1) & mask) {
+			if (!used[pos] || Eq()(KeyOf()(slots[pos]), key)) {
+				return pos;
+			}
+		}
+	}
+
+	void rehash(std::size_t capacity)
+	{
+		std::vector<Slot> old_slots(capacity);
+		std::vector<std::uint8_t> old_used(capacity, 0);
+
+		old_slots.swap(slots);
+		old_used.swap(used);
+
+		for (std::size_t i = 0; i < old_used.size(); ++i) {
+			if (old_used[i]) {
+				auto pos = probe(KeyOf()(old_slots[i]));
+				slots[pos] = std::move(old_slots[i]);
+				used[pos] = 1;
+			}
+		}
+	}
+
+	std::vector<Slot> slots;
+	std::vector<std::uint8_t> used;
+	std::size_t count = 0;
+};
+
+struct PairFirst {
+	template<typename T>
+	const auto &operator()(const T &slot) const { return slot.first; }
+};
+
+struct Identity {
+	template<typename T>
+	const T &operator()(const T &slot) const { return slot; }
+};
+
+} // namespace detail
+
+template<typename K, typename V, typename H = Hash, typename Eq = std::equal_to<K>>
+class FlatMap : public detail::FlatTable<std::pair<K, V>, K, detail::PairFirst, H, Eq> {
+	using Base = detail::FlatTable<std::pair<K, V>, K, detail::PairFirst, H, Eq>;
+
+public:
+	using key_type = K;
+	using mapped_type = V;
+	using value_type = std::pair<K, V>;
+
+	using Base::Base;
+
+	template<typename... Args>
+	std::pair<typename Base::iterator, bool> try_emplace(const K &key, Args &&... args)
+	{
+		return this->insert_with(key, [&] {
+			return value_type(std::piecewise_construct,
+			                  std::forward_as_tuple(key),
+			                  std::forward_as_tuple(std::forward<Args>(args)...));
+		});
+	}
+
+	std::pair<typename Base::iterator, bool> emplace(const K &key, V value)
+	{
+		return try_emplace(key, std::move(value));
+	}
+
+	std::pair<typename Base::iterator, bool> insert(const value_type &kv)
+	{
+		return try_emplace(kv.first, kv.second);
+	}
+
+	V &operator[](const K &key)
+	{
+		return try_emplace(key).first->second;
+	}
+};
+
+template<typename K, typename H = Hash, typename Eq = std::equal_to<K>>
+class FlatSet : public detail::FlatTable<K, K, detail::Identity, H, Eq> {
+	using Base = detail::FlatTable<K, K, detail::Identity, H, Eq>;
+
+public:
+	using key_type = K;
+	using value_type = K;
+
+	using Base::Base;
+
+	// Keys cannot be modified through iterators
+	typename Base::const_iterator begin() const { return Base::begin(); }
+	typename Base::const_iterator end() const { return Base::end(); }
+
+	std::pair<typename Base::const_iterator, bool> insert(const K &key)
+	{
+		auto [it, success] = this->insert_with(key, [&] { return key; });
+
+		return {it, success};
+	}
+};
+
+} // namespace aoc
+
+#endif // AOC_FLAT_MAP_H_INCLUDED
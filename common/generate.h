@@ -0,0 +1,1013 @@
+//
+// Advent of Code 2024, synthetic puzzle inputs
+//
+// Each generator writes a valid input for one day, with the same shape as
+// the real puzzle input, from a random generator and a size. What the size
+// means depends on the day (the side of a grid, the number of lines, ...),
+// and the default size of each generator is roughly that of the puzzle
+// input, so larger sizes can be used to see how the solvers scale.
+//
+// Where the solvers hard-code part of the puzzle (the 101x103 room of day
+// 14, the program of day 17, the 71x71 memory space of day 18 and the
+// two-letter computer names of day 23), the generators keep to it.
+//
+
+#ifndef AOC_GENERATE_H_INCLUDED
+#define AOC_GENERATE_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+using Rng = std::mt19937_64;
+
+// Random integer in [lo, hi]
+template<typename T>
+T uniform(Rng &rng, T lo, T hi)
+{
+	return std::uniform_int_distribution<T>(lo, hi)(rng);
+}
+
+inline bool chance(Rng &rng, double p)
+{
+	return std::bernoulli_distribution(p)(rng);
+}
+
+template<typename T>
+const T &pick(Rng &rng, std::span<const T> values)
+{
+	return values[uniform<std::size_t>(rng, 0, values.size() - 1)];
+}
+
+namespace detail {
+
+template<typename... Args>
+void append(std::string &out, std::format_string<Args...> fmt, Args &&... args)
+{
+	std::format_to(std::back_inserter(out), fmt, std::forward<Args>(args)...);
+}
+
+inline void append_grid(std::string &out, const std::vector<std::string> &grid)
+{
+	for (const auto &row : grid) {
+		out += row;
+		out += '\n';
+	}
+}
+
+// Returns true if the guard starting at (x, y) facing up leaves the grid
+inline bool guard_leaves(const std::vector<std::string> &grid, int x, int y)
+{
+	auto n = static_cast<int>(grid.size());
+
+	std::vector<std::uint8_t> seen(grid.size() * grid.size(), 0);
+
+	int dx = 0;
+	int dy = -1;
+
+	for (int dir = 0; ; ) {
+		if (seen[y * n + x] & (1 << dir)) {
+			return false;
+		}
+
+		seen[y * n + x] |= 1 << dir;
+
+		if (x + dx < 0 || x + dx >= n || y + dy < 0 || y + dy >= n) {
+			return true;
+		}
+
+		if (grid[y + dy][x + dx] == '#') {
+			dir = (dir + 1) % 4;
+			dx = std::exchange(dy, dx) * -1;
+			continue;
+		}
+
+		x += dx;
+		y += dy;
+	}
+}
+
+// Perfect maze on an n x n grid, n odd, with walls on the border
+inline std::vector<std::string> maze(Rng &rng, int n)
+{
+	std::vector<std::string> grid(n, std::string(n, '#'));
+
+	std::vector<std::pair<int, int>> stack = { {1, 1} };
+
+	grid[1][1] = '.';
+
+	while (!stack.empty()) {
+		auto [x, y] = stack.back();
+
+		std::array<std::pair<int, int>, 4> next;
+		std::size_t num_next = 0;
+
+		for (auto [dx, dy] : { std::pair{2, 0}, std::pair{-2, 0}, std::pair{0, 2}, std::pair{0, -2} }) {
+			if (x + dx > 0 && x + dx < n - 1 && y + dy > 0 && y + dy < n - 1 && grid[y + dy][x + dx] == '#') {
+				next[num_next++] = {dx, dy};
+			}
+		}
+
+		if (num_next == 0) {
+			stack.pop_back();
+			continue;
+		}
+
+		auto [dx, dy] = next[uniform<std::size_t>(rng, 0, num_next - 1)];
+
+		grid[y + dy / 2][x + dx / 2] = '.';
+		grid[y + dy][x + dx] = '.';
+
+		stack.emplace_back(x + dx, y + dy);
+	}
+
+	return grid;
+}
+
+inline int num_digits(std::uint64_t value)
+{
+	int digits = 1;
+
+	for (; value >= 10; value /= 10) {
+		++digits;
+	}
+
+	return digits;
+}
+
+} // namespace detail
+
+// Day 1: size lines of two location IDs, where about half of the right
+// IDs also appear in the left list
+inline std::string generate_day01(Rng &rng, long size)
+{
+	std::vector<int> left(size);
+
+	for (auto &id : left) {
+		id = uniform(rng, 10000, 99999);
+	}
+
+	std::string out;
+
+	for (auto id : left) {
+		auto right = chance(rng, 0.5) ? pick<int>(rng, left) : uniform(rng, 10000, 99999);
+
+		detail::append(out, "{}   {}\n", id, right);
+	}
+
+	return out;
+}
+
+// Day 2: size reports of 5 to 8 levels, mostly increasing or decreasing
+// by 1 to 3
+inline std::string generate_day02(Rng &rng, long size)
+{
+	constexpr std::array<int, 10> steps = { 1, 2, 3, 1, 2, 3, 0, 4, 5, -1 };
+
+	std::string out;
+
+	for (long i = 0; i < size; ++i) {
+		int level = uniform(rng, 1, 90);
+		int sign = chance(rng, 0.5) ? 1 : -1;
+
+		detail::append(out, "{}", level);
+
+		for (int n = uniform(rng, 5, 8); n > 1; --n) {
+			level += sign * pick<int>(rng, steps);
+			detail::append(out, " {}", level);
+		}
+
+		out += '\n';
+	}
+
+	return out;
+}
+
+// Day 3: size lines of about 3000 characters of corrupted memory, with
+// valid and broken mul, do and don't instructions
+inline std::string generate_day03(Rng &rng, long size)
+{
+	std::string out;
+
+	auto operand = [&] { return uniform(rng, 0, 999); };
+
+	for (long i = 0; i < size; ++i) {
+		std::size_t line_start = out.size();
+
+		while (out.size() - line_start < 3000) {
+			switch (uniform(rng, 0, 13)) {
+			case 0: detail::append(out, "mul({},{})", operand(), operand()); break;
+			case 1: out += "do()"; break;
+			case 2: out += "don't()"; break;
+			case 3: detail::append(out, "mul[{},{}]", operand(), operand()); break;
+			case 4: detail::append(out, "mul({},{}", operand(), operand()); break;
+			case 5: detail::append(out, "xmul({},{})", operand(), operand()); break;
+			case 6: detail::append(out, "mul({}, {})", operand(), operand()); break;
+			case 7: detail::append(out, "mul(1234,{}){}", operand(), operand()); break;
+			case 8: out += "who()"; break;
+			case 9: out += "&^%$"; break;
+			case 10: detail::append(out, "mul({},{})mul({},{})", operand(), operand(), operand(), operand()); break;
+			case 11: out += "don't"; break;
+			case 12: out += "do("; break;
+			default: detail::append(out, "mmul({},{})", operand(), operand()); break;
+			}
+		}
+
+		out += '\n';
+	}
+
+	return out;
+}
+
+// Day 4: size x size word search of the letters X, M, A and S
+inline std::string generate_day04(Rng &rng, long size)
+{
+	constexpr std::array<char, 4> letters = { 'X', 'M', 'A', 'S' };
+
+	std::vector<std::string> grid(size, std::string(size, '.'));
+
+	for (auto &row : grid) {
+		for (auto &ch : row) {
+			ch = pick<char>(rng, letters);
+		}
+	}
+
+	std::string out;
+
+	detail::append_grid(out, grid);
+
+	return out;
+}
+
+// Day 5: ordering rules for every pair of 49 pages, taken from one total
+// order so every update has one correct order like in the puzzle, followed
+// by size updates with an odd number of pages, about half of them already
+// in the correct order
+inline std::string generate_day05(Rng &rng, long size)
+{
+	std::vector<int> pages(90);
+
+	std::iota(pages.begin(), pages.end(), 10);
+	std::ranges::shuffle(pages, rng);
+	pages.resize(49);
+
+	std::array<std::size_t, 100> rank = {};
+
+	for (auto [i, page] : pages | std::views::enumerate) {
+		rank[page] = i;
+	}
+
+	std::string out;
+
+	for (std::size_t i = 0; i < pages.size(); ++i) {
+		for (std::size_t j = i + 1; j < pages.size(); ++j) {
+			detail::append(out, "{}|{}\n", pages[i], pages[j]);
+		}
+	}
+
+	out += '\n';
+
+	for (long i = 0; i < size; ++i) {
+		auto update = pages;
+
+		std::ranges::shuffle(update, rng);
+		update.resize(2 * uniform(rng, 2, 11) + 1);
+
+		if (chance(rng, 0.5)) {
+			std::ranges::sort(update, {}, [&](int page) { return rank[page]; });
+		}
+
+		for (auto [j, page] : update | std::views::enumerate) {
+			detail::append(out, "{}{}", j == 0 ? "" : ",", page);
+		}
+
+		out += '\n';
+	}
+
+	return out;
+}
+
+// Day 6: size x size lab with about 4.5% obstructions and the guard near
+// the middle, on a path that leaves the lab
+inline std::string generate_day06(Rng &rng, long size)
+{
+	auto n = static_cast<int>(size);
+
+	std::vector<std::string> grid;
+
+	for (;;) {
+		grid.assign(n, std::string(n, '.'));
+
+		for (auto &row : grid) {
+			for (auto &ch : row) {
+				if (chance(rng, 0.045)) {
+					ch = '#';
+				}
+			}
+		}
+
+		int x = uniform(rng, n * 3 / 10, n * 7 / 10);
+		int y = uniform(rng, n * 3 / 10, n * 7 / 10);
+
+		grid[y][x] = '.';
+
+		if (detail::guard_leaves(grid, x, y)) {
+			grid[y][x] = '^';
+			break;
+		}
+	}
+
+	std::string out;
+
+	detail::append_grid(out, grid);
+
+	return out;
+}
+
+// Day 7: size equations of 2 to 12 numbers, most of which can be made
+// true with +, * and ||, and where the test value fits in 63 bits. Like in
+// the puzzle, the sum of all test values also fits in 64 bits.
+inline std::string generate_day07(Rng &rng, long size)
+{
+	const std::uint64_t limit = std::min<std::uint64_t>(
+		std::numeric_limits<std::int64_t>::max(),
+		std::numeric_limits<std::uint64_t>::max() / std::max(size, 1L)
+	);
+
+	std::string out;
+
+	std::vector<std::uint32_t> numbers;
+
+	for (long i = 0; i < size; ) {
+		numbers.resize(uniform(rng, 2, 12));
+
+		for (auto &number : numbers) {
+			number = uniform(rng, 1U, 999U);
+		}
+
+		std::uint64_t value = numbers.front();
+
+		bool overflow = false;
+
+		for (auto number : numbers | std::views::drop(1)) {
+			switch (uniform(rng, 0, 2)) {
+			case 0:
+				overflow = value > limit - number;
+				value += number;
+				break;
+			case 1:
+				overflow = value > limit / number;
+				value *= number;
+				break;
+			default:
+				for (int digit = detail::num_digits(number); digit > 0 && !overflow; --digit) {
+					overflow = value > limit / 10;
+					value *= 10;
+				}
+				overflow = overflow || value > limit - number;
+				value += number;
+				break;
+			}
+
+			if (overflow) {
+				break;
+			}
+		}
+
+		// Try again if the test value got too large
+		if (overflow) {
+			continue;
+		}
+
+		if (chance(rng, 0.4) && value < limit - 5) {
+			value += uniform(rng, 1, 5);
+		}
+
+		detail::append(out, "{}:", value);
+
+		for (auto number : numbers) {
+			detail::append(out, " {}", number);
+		}
+
+		out += '\n';
+
+		++i;
+	}
+
+	return out;
+}
+
+// Day 8: size x size map with antennas on about 8% of the positions
+inline std::string generate_day08(Rng &rng, long size)
+{
+	constexpr std::string_view frequencies = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+	std::vector<std::string> grid(size, std::string(size, '.'));
+
+	for (long i = 0; i < size * size * 2 / 25; ++i) {
+		grid[uniform(rng, 0L, size - 1)][uniform(rng, 0L, size - 1)] = pick<char>(rng, frequencies);
+	}
+
+	std::string out;
+
+	detail::append_grid(out, grid);
+
+	return out;
+}
+
+// Day 9: disk map of size digits (rounded up to odd), alternating file
+// lengths 1 to 9 and free space lengths 0 to 9
+inline std::string generate_day09(Rng &rng, long size)
+{
+	std::string out;
+
+	for (long i = 0; i < (size | 1); ++i) {
+		out += static_cast<char>('0' + (i % 2 == 0 ? uniform(rng, 1, 9) : uniform(rng, 0, 9)));
+	}
+
+	out += '\n';
+
+	return out;
+}
+
+// Day 10: size x size topographic map of rolling hills with some hiking
+// trails from 0 to 9 walked into it
+inline std::string generate_day10(Rng &rng, long size)
+{
+	auto n = static_cast<int>(size);
+
+	std::vector<std::string> grid(n, std::string(n, '0'));
+
+	for (int y = 0; y < n; ++y) {
+		for (int x = 0; x < n; ++x) {
+			auto height = 4.5 + 5 * std::sin(x / 3.0) * std::cos(y / 4.0) + chance(rng, 0.25);
+
+			grid[y][x] = static_cast<char>('0' + std::clamp(static_cast<int>(height), 0, 9));
+		}
+	}
+
+	constexpr std::array<std::array<int, 2>, 4> steps = {{ {1, 0}, {-1, 0}, {0, 1}, {0, -1} }};
+
+	for (long trail = 0; trail < size * size / 90; ++trail) {
+		int x = uniform(rng, 0, n - 1);
+		int y = uniform(rng, 0, n - 1);
+
+		for (char height = '0'; height <= '9'; ++height) {
+			grid[y][x] = height;
+
+			auto [dx, dy] = pick<std::array<int, 2>>(rng, steps);
+
+			x = std::clamp(x + dx, 0, n - 1);
+			y = std::clamp(y + dy, 0, n - 1);
+		}
+	}
+
+	std::string out;
+
+	detail::append_grid(out, grid);
+
+	return out;
+}
+
+// Day 11: one line of size stones with up to 7 digits
+inline std::string generate_day11(Rng &rng, long size)
+{
+	std::string out;
+
+	for (long i = 0; i < size; ++i) {
+		long limit = 1;
+
+		for (int digits = uniform(rng, 1, 7); digits > 0; --digits) {
+			limit *= 10;
+		}
+
+		detail::append(out, "{}{}", i == 0 ? "" : " ", uniform(rng, 0L, limit - 1));
+	}
+
+	out += '\n';
+
+	return out;
+}
+
+// Day 12: size x size garden of five kinds of plants, smoothed into
+// regions
+inline std::string generate_day12(Rng &rng, long size)
+{
+	constexpr std::array<char, 5> plants = { 'A', 'B', 'C', 'D', 'E' };
+
+	std::vector<std::string> grid(size, std::string(size, '.'));
+
+	for (auto &row : grid) {
+		for (auto &ch : row) {
+			ch = pick<char>(rng, plants);
+		}
+	}
+
+	// Grow regions by copying plants down and to the right
+	for (int pass = 0; pass < 3; ++pass) {
+		for (long y = size - 1; y > 0; --y) {
+			for (long x = size - 1; x >= 0; --x) {
+				if (chance(rng, 0.5)) {
+					grid[y][x] = x > 0 && chance(rng, 0.5) ? grid[y][x - 1] : grid[y - 1][x];
+				}
+			}
+		}
+	}
+
+	std::string out;
+
+	detail::append_grid(out, grid);
+
+	return out;
+}
+
+// Day 13: size claw machines, about half of which can be won
+inline std::string generate_day13(Rng &rng, long size)
+{
+	std::string out;
+
+	for (long i = 0; i < size; ++i) {
+		int ax = uniform(rng, 10, 99);
+		int ay = uniform(rng, 10, 99);
+		int bx = uniform(rng, 10, 99);
+		int by = uniform(rng, 10, 99);
+
+		// Keep the buttons linearly independent
+		while (bx * ay == by * ax) {
+			++bx;
+		}
+
+		int prize_x = 0;
+		int prize_y = 0;
+
+		if (chance(rng, 0.5)) {
+			int a = uniform(rng, 1, 100);
+			int b = uniform(rng, 1, 100);
+
+			prize_x = a * ax + b * bx;
+			prize_y = a * ay + b * by;
+		}
+		else {
+			prize_x = uniform(rng, 1000, 20000);
+			prize_y = uniform(rng, 1000, 20000);
+		}
+
+		detail::append(out, "{}Button A: X+{}, Y+{}\n", i == 0 ? "" : "\n", ax, ay);
+		detail::append(out, "Button B: X+{}, Y+{}\n", bx, by);
+		detail::append(out, "Prize: X={}, Y={}\n", prize_x, prize_y);
+	}
+
+	return out;
+}
+
+// Day 14: size robots (at least 30) in the 101x103 room, 30 of which line
+// up vertically after a random number of seconds, with no other robots in
+// that column at the time
+inline std::string generate_day14(Rng &rng, long size)
+{
+	constexpr int width = 101;
+	constexpr int height = 103;
+
+	int seconds = uniform(rng, 50, 5000);
+
+	std::string out;
+
+	for (int i = 0; i < std::max(size, 30L); ++i) {
+		int vx = uniform(rng, -100, 100);
+		int vy = uniform(rng, -100, 100);
+
+		// Position after the given number of seconds
+		int px = uniform(rng, 41, width + 39) % width;
+		int py = uniform(rng, 0, height - 1);
+
+		if (i < 30) {
+			px = 40;
+			py = 30 + i;
+		}
+
+		// Run back to the starting position
+		px = ((px - seconds * vx) % width + width) % width;
+		py = ((py - seconds * vy) % height + height) % height;
+
+		detail::append(out, "p={},{} v={},{}\n", px, py, vx, vy);
+	}
+
+	return out;
+}
+
+// Day 15: size x size warehouse with boxes and walls and the robot in the
+// middle, followed by 400 moves for each row of the warehouse
+inline std::string generate_day15(Rng &rng, long size)
+{
+	constexpr std::string_view tiles = "..O.O..#..";
+	constexpr std::string_view directions = "<>^v";
+
+	std::vector<std::string> grid(size, std::string(size, '#'));
+
+	for (long y = 1; y + 1 < size; ++y) {
+		for (long x = 1; x + 1 < size; ++x) {
+			grid[y][x] = pick<char>(rng, tiles);
+		}
+	}
+
+	grid[size / 2][size / 2] = '@';
+
+	std::string out;
+
+	detail::append_grid(out, grid);
+
+	out += '\n';
+
+	for (long i = 0; i < size * 400; ++i) {
+		out += pick<char>(rng, directions);
+
+		if (i % 1000 == 999) {
+			out += '\n';
+		}
+	}
+
+	if (!out.ends_with('\n')) {
+		out += '\n';
+	}
+
+	return out;
+}
+
+// Day 16: size x size maze (rounded up to odd) with extra openings, so
+// there are several best paths from S in the lower left to E in the
+// upper right
+inline std::string generate_day16(Rng &rng, long size)
+{
+	auto n = static_cast<int>(std::max(size | 1, 5L));
+
+	auto grid = detail::maze(rng, n);
+
+	for (long i = 0; i < size * size / 14; ++i) {
+		grid[uniform(rng, 1, n - 2)][uniform(rng, 1, n - 2)] = '.';
+	}
+
+	grid[n - 2][1] = 'S';
+	grid[1][n - 2] = 'E';
+
+	std::string out;
+
+	detail::append_grid(out, grid);
+
+	return out;
+}
+
+// Day 17: registers and program, the program is the one the part two
+// solver is written for, so the size is not used
+inline std::string generate_day17(Rng &rng, long)
+{
+	std::string out;
+
+	detail::append(out, "Register A: {}\n", uniform(rng, 10'000'000'000'000LL, 100'000'000'000'000LL));
+
+	out += "Register B: 0\n";
+	out += "Register C: 0\n";
+	out += "\n";
+	out += "Program: 2,4,1,3,7,5,4,7,0,3,1,5,5,5,3,0\n";
+
+	return out;
+}
+
+// Day 18: size bytes falling into the 71x71 memory space (at most 5039,
+// the start and exit are never corrupted)
+inline std::string generate_day18(Rng &rng, long size)
+{
+	std::vector<std::pair<int, int>> cells;
+
+	for (int y = 0; y < 71; ++y) {
+		for (int x = 0; x < 71; ++x) {
+			if ((x != 0 || y != 0) && (x != 70 || y != 70)) {
+				cells.emplace_back(x, y);
+			}
+		}
+	}
+
+	std::ranges::shuffle(cells, rng);
+
+	cells.resize(std::min<std::size_t>(cells.size(), size));
+
+	std::string out;
+
+	for (auto [x, y] : cells) {
+		detail::append(out, "{},{}\n", x, y);
+	}
+
+	return out;
+}
+
+// Day 19: towel patterns followed by size designs, most of which can be
+// made from the patterns
+inline std::string generate_day19(Rng &rng, long size)
+{
+	constexpr std::array<std::string_view, 14> towels = {
+		"r", "wr", "b", "g", "bwu", "rb", "gb", "br", "uw", "wg", "bbr", "gu", "rrg", "ub"
+	};
+
+	constexpr std::array<char, 5> colors = { 'w', 'u', 'b', 'r', 'g' };
+
+	std::string out;
+
+	for (auto [i, towel] : towels | std::views::enumerate) {
+		detail::append(out, "{}{}", i == 0 ? "" : ", ", towel);
+	}
+
+	out += "\n\n";
+
+	for (long i = 0; i < size; ++i) {
+		for (int parts = uniform(rng, 8, 25); parts > 0; --parts) {
+			out += pick<std::string_view>(rng, towels);
+		}
+
+		if (chance(rng, 0.3)) {
+			out.append(3, pick<char>(rng, colors));
+		}
+
+		out += '\n';
+	}
+
+	return out;
+}
+
+// Day 20: size x size maze (rounded up to odd) from S in the lower left
+// to E in the upper right
+inline std::string generate_day20(Rng &rng, long size)
+{
+	auto n = static_cast<int>(std::max(size | 1, 5L));
+
+	auto grid = detail::maze(rng, n);
+
+	grid[n - 2][1] = 'S';
+	grid[1][n - 2] = 'E';
+
+	std::string out;
+
+	detail::append_grid(out, grid);
+
+	return out;
+}
+
+// Day 21: size door codes of three digits followed by A
+inline std::string generate_day21(Rng &rng, long size)
+{
+	std::string out;
+
+	for (long i = 0; i < size; ++i) {
+		detail::append(out, "{:03}A\n", uniform(rng, 1, 999));
+	}
+
+	return out;
+}
+
+// Day 22: initial secret numbers of size buyers
+inline std::string generate_day22(Rng &rng, long size)
+{
+	std::string out;
+
+	for (long i = 0; i < size; ++i) {
+		detail::append(out, "{}\n", uniform(rng, 1, (1 << 24) - 1));
+	}
+
+	return out;
+}
+
+// Day 23: size connections between computers with two-letter names, at
+// most one between each pair of the 676 possible names, including a LAN
+// party of 13 computers
+inline std::string generate_day23(Rng &rng, long size)
+{
+	constexpr int num_names = 26 * 26;
+
+	auto name = [](int id) {
+		return std::string{ static_cast<char>('a' + id / 26), static_cast<char>('a' + id % 26) };
+	};
+
+	// Use enough computers for about 13 connections each
+	auto num_computers = static_cast<int>(std::clamp(size * 2 / 13, 13L, long{num_names}));
+
+	auto num_connections = std::min(size, static_cast<long>(num_computers) * (num_computers - 1) / 2);
+
+	std::vector<int> computers(num_names);
+
+	std::iota(computers.begin(), computers.end(), 0);
+	std::ranges::shuffle(computers, rng);
+	computers.resize(num_computers);
+
+	std::unordered_set<int> connections;
+
+	std::string out;
+
+	auto connect = [&](int a, int b) {
+		if (a != b && connections.insert(std::min(a, b) * num_names + std::max(a, b)).second) {
+			detail::append(out, "{}-{}\n", name(a), name(b));
+		}
+	};
+
+	for (int i = 0; i < 13; ++i) {
+		for (int j = i + 1; j < 13; ++j) {
+			connect(computers[i], computers[j]);
+		}
+	}
+
+	while (std::ssize(connections) < num_connections) {
+		connect(pick<int>(rng, computers), pick<int>(rng, computers));
+	}
+
+	return out;
+}
+
+// Day 24: initial wire values and the gates of a size-bit ripple-carry
+// adder in random order, where the outputs of a pair of gates have been
+// swapped in four of the full adders (if there are at least 9 bits)
+inline std::string generate_day24(Rng &rng, long size)
+{
+	auto bits = static_cast<int>(size);
+
+	std::unordered_set<std::string> used;
+
+	auto new_wire = [&] {
+		for (;;) {
+			// Names starting with x, y or z are inputs and outputs
+			std::string name = {
+				static_cast<char>('a' + uniform(rng, 0, 22)),
+				static_cast<char>('a' + uniform(rng, 0, 25)),
+				static_cast<char>('a' + uniform(rng, 0, 25))
+			};
+
+			if (used.insert(name).second) {
+				return name;
+			}
+		}
+	};
+
+	// Each gate is lhs, op, rhs and output, the full adder of bit i starts
+	// at index 5 * i - 3
+	std::vector<std::array<std::string, 4>> gates;
+
+	std::string carry;
+
+	for (int i = 0; i < bits; ++i) {
+		auto x = std::format("x{:02}", i);
+		auto y = std::format("y{:02}", i);
+		auto z = std::format("z{:02}", i);
+
+		if (i == 0) {
+			carry = new_wire();
+			gates.push_back({ x, "XOR", y, z });
+			gates.push_back({ x, "AND", y, carry });
+			continue;
+		}
+
+		auto sum = new_wire();
+		auto carry1 = new_wire();
+		auto carry2 = new_wire();
+		auto carry_out = i + 1 == bits ? std::format("z{:02}", bits) : new_wire();
+
+		gates.push_back({ x, "XOR", y, sum });
+		gates.push_back({ sum, "XOR", carry, z });
+		gates.push_back({ x, "AND", y, carry1 });
+		gates.push_back({ sum, "AND", carry, carry2 });
+		gates.push_back({ carry1, "OR", carry2, carry_out });
+
+		carry = carry_out;
+	}
+
+	// Pairs of gates in a full adder that can be swapped without making
+	// a cycle
+	constexpr std::array<std::pair<int, int>, 3> swaps = {{ {0, 2}, {1, 4}, {1, 3} }};
+
+	// Swap in full adders at least two apart, so each wrong sum can be
+	// fixed by a single swap
+	if (bits >= 9) {
+		std::vector<int> adders(bits - 2);
+
+		std::iota(adders.begin(), adders.end(), 1);
+
+		do {
+			std::ranges::shuffle(adders, rng);
+			std::ranges::sort(adders.begin(), adders.begin() + 4);
+		} while (adders[1] - adders[0] < 2 || adders[2] - adders[1] < 2 || adders[3] - adders[2] < 2);
+
+		for (auto adder : adders | std::views::take(4)) {
+			auto [a, b] = pick<std::pair<int, int>>(rng, swaps);
+
+			std::swap(gates[5 * adder - 3 + a][3], gates[5 * adder - 3 + b][3]);
+		}
+	}
+
+	std::string out;
+
+	for (char input : { 'x', 'y' }) {
+		for (int i = 0; i < bits; ++i) {
+			detail::append(out, "{}{:02}: {}\n", input, i, uniform(rng, 0, 1));
+		}
+	}
+
+	out += '\n';
+
+	std::ranges::shuffle(gates, rng);
+
+	for (const auto &[lhs, op, rhs, wire] : gates) {
+		detail::append(out, "{} {} {} -> {}\n", lhs, op, rhs, wire);
+	}
+
+	return out;
+}
+
+// Day 25: size lock and key schematics
+inline std::string generate_day25(Rng &rng, long size)
+{
+	std::string out;
+
+	for (long i = 0; i < size; ++i) {
+		bool lock = chance(rng, 0.5);
+
+		std::array<int, 5> heights = {};
+
+		for (auto &height : heights) {
+			height = uniform(rng, 0, 5);
+		}
+
+		if (i != 0) {
+			out += '\n';
+		}
+
+		// Locks fill from the top row down, keys from the bottom row up
+		for (int row = 0; row < 7; ++row) {
+			for (auto height : heights) {
+				bool filled = lock ? row <= height : 6 - row <= height;
+
+				out += (lock && row == 0) || (!lock && row == 6) || filled ? '#' : '.';
+			}
+
+			out += '\n';
+		}
+	}
+
+	return out;
+}
+
+struct Generator {
+	int day;
+	long default_size;
+	std::string_view size_meaning;
+	std::string (*generate)(Rng &rng, long size);
+};
+
+inline constexpr std::array generators = {
+	Generator{  1,  1000, "lines", generate_day01 },
+	Generator{  2,  1000, "reports", generate_day02 },
+	Generator{  3,     6, "lines of 3000 characters", generate_day03 },
+	Generator{  4,   140, "side of the grid", generate_day04 },
+	Generator{  5,   200, "updates", generate_day05 },
+	Generator{  6,   130, "side of the grid", generate_day06 },
+	Generator{  7,   850, "equations", generate_day07 },
+	Generator{  8,    50, "side of the grid", generate_day08 },
+	Generator{  9, 19999, "digits", generate_day09 },
+	Generator{ 10,    60, "side of the grid", generate_day10 },
+	Generator{ 11,     8, "stones", generate_day11 },
+	Generator{ 12,   140, "side of the grid", generate_day12 },
+	Generator{ 13,   320, "machines", generate_day13 },
+	Generator{ 14,   500, "robots", generate_day14 },
+	Generator{ 15,    50, "side of the grid", generate_day15 },
+	Generator{ 16,   141, "side of the grid", generate_day16 },
+	Generator{ 17,     1, "not used", generate_day17 },
+	Generator{ 18,  3450, "bytes", generate_day18 },
+	Generator{ 19,   400, "designs", generate_day19 },
+	Generator{ 20,   141, "side of the grid", generate_day20 },
+	Generator{ 21,     5, "codes", generate_day21 },
+	Generator{ 22,  2000, "buyers", generate_day22 },
+	Generator{ 23,  3380, "connections", generate_day23 },
+	Generator{ 24,    45, "bits", generate_day24 },
+	Generator{ 25,   500, "schematics", generate_day25 },
+};
+
+inline const Generator *find_generator(int day)
+{
+	auto it = std::ranges::find(generators, day, &Generator::day);
+
+	return it != generators.end() ? &*it : nullptr;
+}
+
+} // namespace aoc
+
+#endif // AOC_GENERATE_H_INCLUDED
@@ -0,0 +1,176 @@
+//
+// Advent of Code 2024, common grid type
+//
+// Grid<T> stores a two-dimensional map in one contiguous row-major buffer,
+// optionally surrounded by a border of sentinel cells, so walking off the
+// edge of the map can be detected by looking at the value instead of
+// checking coordinates.
+//
+// Coordinates (x, y) refer to the map itself, so (0, 0) is the first cell
+// read, and the padding is at x = -padding .. -1 and width .. width + padding
+// - 1 (and likewise for y). Each cell also has a flat index into the buffer,
+// and moving by (dx, dy) is adding offset(dx, dy) to the index.
+//
+
+#ifndef AOC_GRID_H_INCLUDED
+#define AOC_GRID_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "input.h"
+
+namespace aoc {
+
+// Down, left, up, right
+inline constexpr std::array<std::array<int, 2>, 4> directions4 = {{
+	{ 0, 1 }, { -1, 0 }, { 0, -1 }, { 1, 0 }
+}};
+
+// All eight neighbours, clockwise starting from down
+inline constexpr std::array<std::array<int, 2>, 8> directions8 = {{
+	{ 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 },
+	{ 0, -1 }, { -1, -1 }, { -1, 0 }, { -1, 1 }
+}};
+
+template<typename T>
+class Grid {
+public:
+	using value_type = T;
+
+	Grid() = default;
+
+	Grid(int width, int height, int padding = 0, const T &value = T{})
+		: width_(width), height_(height), padding_(padding),
+		  stride_(width + 2 * padding),
+		  cells_(static_cast<std::size_t>(stride_) * (height + 2 * padding), value) {}
+
+	int width() const { return width_; }
+	int height() const { return height_; }
+	int padding() const { return padding_; }
+	int stride() const { return stride_; }
+
+	std::ptrdiff_t index(int x, int y) const
+	{
+		return static_cast<std::ptrdiff_t>(y + padding_) * stride_ + (x + padding_);
+	}
+
+	std::pair<int, int> coords(std::ptrdiff_t idx) const
+	{
+		return {static_cast<int>(idx % stride_) - padding_,
+		        static_cast<int>(idx / stride_) - padding_};
+	}
+
+	std::ptrdiff_t offset(int dx, int dy) const
+	{
+		return static_cast<std::ptrdiff_t>(dy) * stride_ + dx;
+	}
+
+	template<std::size_t N>
+	std::array<std::ptrdiff_t, N> offsets(const std::array<std::array<int, 2>, N> &directions) const
+	{
+		std::array<std::ptrdiff_t, N> res = {};
+
+		for (std::size_t i = 0; i < N; ++i) {
+			res[i] = offset(directions[i][0], directions[i][1]);
+		}
+
+		return res;
+	}
+
+	bool contains(int x, int y) const
+	{
+		return x >= 0 && x < width_ && y >= 0 && y < height_;
+	}
+
+	T &operator()(int x, int y) { return cells_[index(x, y)]; }
+	const T &operator()(int x, int y) const { return cells_[index(x, y)]; }
+
+	T &operator[](std::ptrdiff_t idx) { return cells_[idx]; }
+	const T &operator[](std::ptrdiff_t idx) const { return cells_[idx]; }
+
+	// Cells of row y, excluding padding
+	std::span<T> row(int y) { return {&cells_[index(0, y)], static_cast<std::size_t>(width_)}; }
+	std::span<const T> row(int y) const { return {&cells_[index(0, y)], static_cast<std::size_t>(width_)}; }
+
+	// Cells of row y, including padding (y may be in the padding)
+	std::span<T> padded_row(int y) { return {&cells_[index(-padding_, y)], static_cast<std::size_t>(stride_)}; }
+	std::span<const T> padded_row(int y) const { return {&cells_[index(-padding_, y)], static_cast<std::size_t>(stride_)}; }
+
+	// Set all padding cells to value
+	void fill_padding(const T &value)
+	{
+		for (int y = -padding_; y < height_ + padding_; ++y) {
+			for (int x = -padding_; x < width_ + padding_; ++x) {
+				if (!contains(x, y)) {
+					(*this)(x, y) = value;
+				}
+			}
+		}
+	}
+
+	// Flat index of first cell equal to value, or -1 if not found
+	std::ptrdiff_t find(const T &value) const
+	{
+		auto it = std::ranges::find(cells_, value);
+
+		return it != cells_.end() ? it - cells_.begin() : -1;
+	}
+
+	// Iteration is over all cells, including padding
+	auto begin() { return cells_.begin(); }
+	auto end() { return cells_.end(); }
+	auto begin() const { return cells_.begin(); }
+	auto end() const { return cells_.end(); }
+
+	std::size_t size() const { return cells_.size(); }
+
+	T *data() { return cells_.data(); }
+	const T *data() const { return cells_.data(); }
+
+private:
+	int width_ = 0;
+	int height_ = 0;
+	int padding_ = 0;
+	int stride_ = 0;
+	std::vector<T> cells_;
+};
+
+// Create grid from a range of lines of equal length, surrounded by padding
+// cells with value pad. Throws InputError if a line has another length.
+Grid<char> make_grid(const auto &lines, int padding = 0, char pad = '.')
+{
+	const int height = static_cast<int>(std::ranges::size(lines));
+	const int width = height != 0 ? static_cast<int>(std::ranges::size(*std::ranges::begin(lines))) : 0;
+
+	Grid<char> grid(width, height, padding, pad);
+
+	int y = 0;
+
+	for (const auto &line : lines) {
+		if (static_cast<int>(std::ranges::size(line)) != width) {
+			throw InputError(std::format("line {} of the grid has length {}, expected {}",
+			                             y + 1, std::ranges::size(line), width));
+		}
+
+		std::ranges::copy(line, grid.row(y).begin());
+		++y;
+	}
+
+	return grid;
+}
+
+// Read lines up to an empty line or end of input into a grid
+inline Grid<char> read_grid(Scanner &in, int padding = 0, char pad = '.')
+{
+	return make_grid(in.lines(), padding, pad);
+}
+
+} // namespace aoc
+
+#endif // AOC_GRID_H_INCLUDED
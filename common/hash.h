@@ -0,0 +1,60 @@
+//
+// Advent of Code 2024, common hash function
+//
+// aoc::Hash hashes integers, strings and any tuple-like type (std::pair,
+// std::tuple, std::array) of those. Each value is run through the splitmix64
+// finalizer, so keys that differ only in a few low bits (like neighbouring
+// coordinates) still spread over the whole table, which matters for the
+// power-of-two sized open-addressing tables in flat_map.h.
+//
+
+#ifndef AOC_HASH_H_INCLUDED
+#define AOC_HASH_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+namespace aoc {
+
+constexpr std::uint64_t mix64(std::uint64_t x)
+{
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBULL;
+	x ^= x >> 31;
+	return x;
+}
+
+template<typename T>
+concept TupleLike = requires { std::tuple_size<T>::value; };
+
+struct Hash {
+	template<typename T>
+	std::size_t operator()(const T &value) const noexcept
+	{
+		if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+			return mix64(static_cast<std::uint64_t>(value));
+		}
+		else if constexpr (TupleLike<T>) {
+			std::uint64_t hash = 0;
+			std::apply([&](const auto &... elems) {
+				(..., (hash = mix64(hash + (*this)(elems))));
+			}, value);
+			return hash;
+		}
+		else {
+			return mix64(std::hash<T>()(value));
+		}
+	}
+};
+
+static_assert(mix64(0) == 0);
+static_assert(mix64(1) != mix64(2));
+
+} // namespace aoc
+
+#endif // AOC_HASH_H_INCLUDED
@@ -0,0 +1,431 @@
+//
+// Advent of Code 2024, fast input handling
+//
+// read_input() maps the file named on the command line into memory, or
+// reads all of standard input into one buffer if there is none. Named
+// pipes and other files that cannot be mapped are read as well. The
+// solvers then parse the text in place through std::string_view slices,
+// without the per-character overhead of iostreams or copying lines.
+//
+// Scanner is a cursor over the text which hands out lines and parses
+// integers with std::from_chars.
+//
+// Solvers throw InputError for input they cannot handle. The drivers in
+// solver.h report it, and when several days share a process, only the day
+// with the bad input is skipped.
+//
+// split_lines() divides the text into chunks of whole lines, so large
+// inputs can be parsed on several threads.
+//
+// read_blocks() instead reads a file a block at a time, for solvers that
+// stream their input in constant memory, and read_lines() splits the blocks
+// into lines.
+//
+
+#ifndef AOC_INPUT_H_INCLUDED
+#define AOC_INPUT_H_INCLUDED
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define AOC_HAVE_MMAP 1
+#endif
+
+namespace aoc {
+
+// Input that a solver cannot handle, what() says why
+class InputError : public std::runtime_error {
+public:
+	using std::runtime_error::runtime_error;
+};
+
+// Entire input, either memory mapped or held in a buffer
+class Input {
+public:
+	Input() = default;
+
+	explicit Input(std::string text) : buffer(std::move(text)) {}
+
+	Input(const Input &) = delete;
+	Input &operator=(const Input &) = delete;
+
+	Input(Input &&other) noexcept
+		: buffer(std::move(other.buffer)),
+		  mapping(std::exchange(other.mapping, nullptr)),
+		  mapping_size(std::exchange(other.mapping_size, 0)) {}
+
+	Input &operator=(Input &&other) noexcept
+	{
+		if (this != &other) {
+			unmap();
+			buffer = std::move(other.buffer);
+			mapping = std::exchange(other.mapping, nullptr);
+			mapping_size = std::exchange(other.mapping_size, 0);
+		}
+
+		return *this;
+	}
+
+	~Input() { unmap(); }
+
+	// Map the file at path into memory, or read it if mmap is unavailable
+	static Input from_file(const char *path)
+	{
+		Input input;
+
+#ifdef AOC_HAVE_MMAP
+		int fd = ::open(path, O_RDONLY);
+
+		struct stat st = {};
+
+		if (fd == -1 || ::fstat(fd, &st) == -1) {
+			fail(path);
+		}
+
+		// Pipes and other special files have no size to map, so read them
+		if (!S_ISREG(st.st_mode) || st.st_size == 0) {
+			std::FILE *fp = ::fdopen(fd, "rb");
+
+			if (fp == nullptr) {
+				fail(path);
+			}
+
+			input.buffer = read_all(fp);
+
+			std::fclose(fp);
+
+			return input;
+		}
+
+		void *p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (p == MAP_FAILED) {
+			fail(path);
+		}
+
+		::madvise(p, st.st_size, MADV_SEQUENTIAL);
+
+		input.mapping = p;
+		input.mapping_size = st.st_size;
+
+		::close(fd);
+#else
+		std::FILE *fp = std::fopen(path, "rb");
+
+		if (fp == nullptr) {
+			fail(path);
+		}
+
+		input.buffer = read_all(fp);
+
+		std::fclose(fp);
+#endif
+
+		return input;
+	}
+
+	static Input from_stdin()
+	{
+		return Input(read_all(stdin));
+	}
+
+	std::string_view text() const
+	{
+		if (mapping != nullptr) {
+			return {static_cast<const char *>(mapping), mapping_size};
+		}
+
+		return buffer;
+	}
+
+private:
+	[[noreturn]] static void fail(const char *path)
+	{
+		std::println(std::cerr, "unable to read '{}'", path);
+		std::exit(1);
+	}
+
+	static std::string read_all(std::FILE *fp)
+	{
+		std::string text;
+
+		std::size_t size = 0;
+
+		for (;;) {
+			text.resize(size + 64 * 1024);
+
+			auto num_read = std::fread(text.data() + size, 1, text.size() - size, fp);
+
+			size += num_read;
+
+			if (num_read == 0) {
+				break;
+			}
+		}
+
+		text.resize(size);
+
+		return text;
+	}
+
+	void unmap()
+	{
+#ifdef AOC_HAVE_MMAP
+		if (mapping != nullptr) {
+			::munmap(mapping, mapping_size);
+			mapping = nullptr;
+			mapping_size = 0;
+		}
+#endif
+	}
+
+	std::string buffer;
+	void *mapping = nullptr;
+	std::size_t mapping_size = 0;
+};
+
+// Read the file given as first argument, or standard input
+inline Input read_input(int argc, char *argv[])
+{
+	if (argc > 1) {
+		return Input::from_file(argv[1]);
+	}
+
+	return Input::from_stdin();
+}
+
+// Parse the integer at the start of str, returns 0 if there is none
+template<std::integral T = long>
+T to_number(std::string_view str)
+{
+	T value = 0;
+
+	std::from_chars(str.data(), str.data() + str.size(), value);
+
+	return value;
+}
+
+// Cursor over input text
+class Scanner {
+public:
+	Scanner() = default;
+
+	explicit Scanner(std::string_view text) : rest(text) {}
+
+	bool empty() const { return rest.empty(); }
+
+	// Text not consumed yet
+	std::string_view remaining() const { return rest; }
+
+	// Get next line without the line ending, returns false at end of input
+	bool getline(std::string_view &line)
+	{
+		if (rest.empty()) {
+			return false;
+		}
+
+		auto pos = rest.find('\n');
+
+		if (pos == std::string_view::npos) {
+			line = rest;
+			rest = {};
+		}
+		else {
+			line = rest.substr(0, pos);
+			rest.remove_prefix(pos + 1);
+		}
+
+		if (line.ends_with('\r')) {
+			line.remove_suffix(1);
+		}
+
+		return true;
+	}
+
+	// Next line, or empty at end of input
+	std::string_view line()
+	{
+		std::string_view line;
+
+		getline(line);
+
+		return line;
+	}
+
+	// Lines up to the next empty line or end of input
+	std::vector<std::string_view> lines()
+	{
+		std::vector<std::string_view> res;
+
+		for (std::string_view line; getline(line) && !line.empty(); ) {
+			res.push_back(line);
+		}
+
+		return res;
+	}
+
+	// Skip to and parse the next integer in each of values, returns false
+	// if the input ran out first. Throws InputError for an integer that
+	// does not fit its value.
+	template<std::integral... Ts>
+	bool next(Ts &... values)
+	{
+		return (... && next_one(values));
+	}
+
+private:
+	template<std::integral T>
+	bool next_one(T &value)
+	{
+		const char *p = rest.data();
+		const char *end = p + rest.size();
+
+		for (; p != end; ++p) {
+			if (*p >= '0' && *p <= '9') {
+				break;
+			}
+
+			if constexpr (std::is_signed_v<T>) {
+				if (*p == '-' && p + 1 != end && p[1] >= '0' && p[1] <= '9') {
+					break;
+				}
+			}
+		}
+
+		if (p == end) {
+			rest = {};
+			return false;
+		}
+
+		auto [ptr, ec] = std::from_chars(p, end, value);
+
+		if (ec == std::errc::result_out_of_range) {
+			throw InputError(std::format("number {} is out of range", std::string_view(p, ptr)));
+		}
+
+		rest.remove_prefix(ptr - rest.data());
+
+		return ec == std::errc{};
+	}
+
+	std::string_view rest;
+};
+
+// All integers in text
+template<std::integral T = long>
+std::vector<T> numbers(std::string_view text)
+{
+	std::vector<T> res;
+
+	Scanner scanner(text);
+
+	for (T value = 0; scanner.next(value); ) {
+		res.push_back(value);
+	}
+
+	return res;
+}
+
+// Split text into at most num_chunks slices of about equal size, each ending
+// after a newline or at the end of text, so no line is divided
+inline std::vector<std::string_view> split_lines(std::string_view text, std::size_t num_chunks)
+{
+	std::vector<std::string_view> chunks;
+
+	std::size_t begin = 0;
+
+	for (std::size_t chunk = 1; chunk <= num_chunks && begin < text.size(); ++chunk) {
+		auto end = text.find('\n', std::max(begin, text.size() * chunk / num_chunks));
+
+		end = end == std::string_view::npos ? text.size() : end + 1;
+
+		chunks.push_back(text.substr(begin, end - begin));
+
+		begin = end;
+	}
+
+	return chunks;
+}
+
+// Read fp in blocks of up to block_size bytes, and call fn(block) with each
+// as a std::string_view, until the input ends or fn returns false. Check
+// std::ferror(fp) afterwards for read errors.
+template<typename Fn>
+void read_blocks(std::FILE *fp, std::size_t block_size, Fn fn)
+{
+	std::vector<char> block(block_size);
+
+	for (;;) {
+		auto num_read = std::fread(block.data(), 1, block.size(), fp);
+
+		if (num_read == 0 || !fn(std::string_view(block.data(), num_read))) {
+			break;
+		}
+	}
+}
+
+// Read fp a line at a time, and call fn(line) with each, without the line
+// ending, until the input ends or fn returns false. Lines that continue in
+// the next block are put together in a buffer of their own.
+template<typename Fn>
+void read_lines(std::FILE *fp, Fn fn)
+{
+	std::string partial;
+
+	auto strip_cr = [](std::string_view line) {
+		return line.ends_with('\r') ? line.substr(0, line.size() - 1) : line;
+	};
+
+	bool done = false;
+
+	read_blocks(fp, std::size_t{64} * 1024, [&](std::string_view block) {
+		for (auto pos = block.find('\n'); pos != std::string_view::npos; pos = block.find('\n')) {
+			std::string_view line = block.substr(0, pos);
+
+			if (!partial.empty()) {
+				partial.append(line);
+				line = partial;
+			}
+
+			done = !fn(strip_cr(line));
+
+			partial.clear();
+
+			if (done) {
+				return false;
+			}
+
+			block.remove_prefix(pos + 1);
+		}
+
+		partial.append(block);
+
+		return true;
+	});
+
+	if (!done && !partial.empty()) {
+		fn(strip_cr(partial));
+	}
+}
+
+} // namespace aoc
+
+#endif // AOC_INPUT_H_INCLUDED
@@ -0,0 +1,178 @@
+//
+// Advent of Code 2024, hardware performance counters
+//
+// perf_count() reads hardware counters of the calling thread through the
+// Linux perf_event_open system call, and is used by PhaseTimer when built
+// with AOC_PERF_COUNTERS. The counters are opened the first time a thread
+// reads them.
+//
+// Threads started after that are counted as well, but the kernel only adds
+// their counts once they have exited. The threads of aoc::shared_pool() run
+// until the process ends, so parallel_for() instead reads the counters of
+// the workers around each chunk it hands them, and adds the differences to
+// the counts of the calling thread with add_offloaded_perf(). The work the
+// solvers split over the pool is then included in their solve phase.
+//
+// Counters that cannot be opened read as -1. That is every counter on other
+// systems than Linux, and often some or all of them in virtual machines or
+// when kernel.perf_event_paranoid is above 2. If the CPU has fewer counters
+// than requested, the kernel takes turns counting them, and the values are
+// scaled up to the time they were enabled.
+//
+
+#ifndef AOC_PERF_COUNTERS_H_INCLUDED
+#define AOC_PERF_COUNTERS_H_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#  include <linux/perf_event.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  define AOC_HAVE_PERF_EVENT 1
+#endif
+
+namespace aoc {
+
+inline constexpr std::array<std::string_view, 5> perf_event_names = {
+	"cycles", "instructions", "L1d misses", "LLC misses", "branch misses"
+};
+
+using PerfCount = std::array<std::int64_t, perf_event_names.size()>;
+
+namespace detail {
+
+#ifdef AOC_HAVE_PERF_EVENT
+class PerfEvents {
+public:
+	PerfEvents()
+	{
+		constexpr auto l1d_read_miss = PERF_COUNT_HW_CACHE_L1D
+		                             | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+		                             | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+		constexpr std::array<std::pair<std::uint32_t, std::uint64_t>, perf_event_names.size()> events = {{
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HW_CACHE, l1d_read_miss },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+		}};
+
+		for (std::size_t i = 0; i < events.size(); ++i) {
+			perf_event_attr attr = {};
+
+			attr.size = sizeof(attr);
+			attr.type = events[i].first;
+			attr.config = events[i].second;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			attr.inherit = 1;
+
+			// Count this thread and the threads it starts, on any CPU
+			fds[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+	}
+
+	PerfEvents(const PerfEvents &) = delete;
+	PerfEvents &operator=(const PerfEvents &) = delete;
+
+	~PerfEvents()
+	{
+		for (auto fd : fds) {
+			if (fd != -1) {
+				::close(fd);
+			}
+		}
+	}
+
+	PerfCount read() const
+	{
+		PerfCount res;
+
+		for (std::size_t i = 0; i < fds.size(); ++i) {
+			std::uint64_t values[3] = {};
+
+			if (fds[i] == -1 || ::read(fds[i], values, sizeof(values)) != sizeof(values)) {
+				res[i] = -1;
+				continue;
+			}
+
+			auto [value, enabled, running] = values;
+
+			res[i] = running != 0 && running < enabled
+			       ? static_cast<std::int64_t>(static_cast<double>(value) * enabled / running)
+			       : static_cast<std::int64_t>(value);
+		}
+
+		return res;
+	}
+
+private:
+	std::array<int, perf_event_names.size()> fds;
+};
+#endif
+
+// Counts of work done for this thread on other threads
+inline PerfCount &offloaded_perf()
+{
+	static thread_local PerfCount counts = {};
+	return counts;
+}
+
+} // namespace detail
+
+// Counter values of this thread, the threads it started that have exited,
+// and the work done for it on a thread pool, so far
+inline PerfCount perf_count()
+{
+#ifdef AOC_HAVE_PERF_EVENT
+	static thread_local const detail::PerfEvents events;
+
+	auto res = events.read();
+
+	const auto &offloaded = detail::offloaded_perf();
+
+	for (std::size_t i = 0; i < res.size(); ++i) {
+		if (res[i] >= 0) {
+			res[i] += offloaded[i];
+		}
+	}
+
+	return res;
+#else
+	PerfCount res;
+	res.fill(-1);
+	return res;
+#endif
+}
+
+// Add the counts from before to after to total, for the counters that are
+// available in both
+inline void add_perf_difference(PerfCount &total, const PerfCount &before, const PerfCount &after)
+{
+	for (std::size_t i = 0; i < total.size(); ++i) {
+		if (before[i] >= 0 && after[i] >= 0) {
+			total[i] += after[i] - before[i];
+		}
+	}
+}
+
+// Add counts of work done for this thread on other threads to its counts
+inline void add_offloaded_perf(const PerfCount &counts)
+{
+	auto &offloaded = detail::offloaded_perf();
+
+	for (std::size_t i = 0; i < offloaded.size(); ++i) {
+		offloaded[i] += counts[i];
+	}
+}
+
+} // namespace aoc
+
+#endif // AOC_PERF_COUNTERS_H_INCLUDED
@@ -0,0 +1,78 @@
+//
+// Advent of Code 2024, radix sort for integers
+//
+// radix_sort() sorts non-negative integers with an LSD radix sort, 11 bits
+// per pass, and only as many passes as the largest value needs. Five digit
+// numbers take two passes over the data, each a linear scatter, instead of
+// the log n passes of a comparison sort. Inputs with negative values are
+// sorted with std::ranges::sort.
+//
+
+#ifndef AOC_RADIX_SORT_H_INCLUDED
+#define AOC_RADIX_SORT_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+template<std::integral T>
+void radix_sort(std::vector<T> &values)
+{
+	constexpr int radix_bits = 11;
+	constexpr std::size_t radix = std::size_t{1} << radix_bits;
+
+	using U = std::make_unsigned_t<T>;
+
+	if (values.size() < 2) {
+		return;
+	}
+
+	auto [min, max] = std::ranges::minmax(values);
+
+	if (min < 0) {
+		std::ranges::sort(values);
+		return;
+	}
+
+	int num_passes = (std::bit_width(static_cast<U>(max)) + radix_bits - 1) / radix_bits;
+
+	// Count the digits of all passes in one go
+	std::vector<std::array<std::size_t, radix>> counts(num_passes);
+
+	for (auto value : values) {
+		auto u = static_cast<U>(value);
+
+		for (int pass = 0; pass < num_passes; ++pass) {
+			++counts[pass][(u >> (pass * radix_bits)) & (radix - 1)];
+		}
+	}
+
+	std::vector<T> scratch(values.size());
+
+	for (int pass = 0; pass < num_passes; ++pass) {
+		auto &offsets = counts[pass];
+
+		std::size_t sum = 0;
+
+		for (auto &offset : offsets) {
+			sum += std::exchange(offset, sum);
+		}
+
+		for (auto value : values) {
+			scratch[offsets[(static_cast<U>(value) >> (pass * radix_bits)) & (radix - 1)]++] = value;
+		}
+
+		values.swap(scratch);
+	}
+}
+
+} // namespace aoc
+
+#endif // AOC_RADIX_SORT_H_INCLUDED
@@ -0,0 +1,603 @@
+//
+// Advent of Code 2024, common command line driver
+//
+// Each solver is split into three phases:
+//
+//   parse(aoc::Scanner &in) -> Data
+//   solve(Data) -> Result
+//   print(std::FILE *out, const Result &)
+//
+// and AOC_SOLVER(parse, solve, print) at the end of the file, outside the
+// anonymous namespace holding the rest of the code, ties them together.
+//
+// Normally AOC_SOLVER defines main(), which hands the phases to aoc::run()
+// and gives every program the same command line:
+//
+//   dec2024DD_N [--repeat N] [--time] [input]
+//
+// The input is read from the named file, or stdin if there is none, and
+// loaded once. With --repeat, parse and solve are run N times on it, and
+// the result of the last run is printed. With --time, the duration of each
+// phase is written to stderr.
+//
+// When built with AOC_TRACK_ALLOCATIONS, the heap allocations of each phase
+// are recorded as well (see alloc_count.h), and reported with the times.
+// Likewise AOC_PERF_COUNTERS records hardware performance counters like
+// cycles and cache misses (see perf_counters.h).
+//
+// If the result of solve has a member function items(), returning how many
+// input records it processed, the throughput of solve is reported as well.
+//
+// Solvers that parse their input in the same pass as they solve it return
+// aoc::Unparsed from parse, handing the text on to solve. The parse phase
+// then takes no time, and is reported as done while solving.
+//
+// Solvers that can work through their input a piece at a time may end with
+// AOC_STREAMING_SOLVER(parse, solve, print, stream) instead, where
+//
+//   stream(std::FILE *in) -> Result
+//
+// reads the input itself. The program then also accepts --stream, which
+// hands it the input file or stdin unread, so input piped from another
+// process is handled without loading all of it. The time taken by stream
+// is reported as the solve phase.
+//
+// Parse and solve may throw aoc::InputError (see input.h) for input they
+// cannot handle, which is reported instead of a result.
+//
+// If AOC_SOLVER_NAME is defined, AOC_SOLVER instead adds the solver to
+// aoc::solvers() under that name, so several days can be linked into one
+// program like the benchmarks. The benchmarks also use prepare() to parse
+// the input once and time solve on its own.
+//
+
+#ifndef AOC_SOLVER_H_INCLUDED
+#define AOC_SOLVER_H_INCLUDED
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <print>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "input.h"
+
+#ifdef AOC_TRACK_ALLOCATIONS
+#  include "alloc_count.h"
+#endif
+
+#ifdef AOC_PERF_COUNTERS
+#  include "perf_counters.h"
+#endif
+
+namespace aoc {
+
+// Input text handed on from parse to solve, for solvers that parse while
+// solving
+struct Unparsed {
+	std::string_view text;
+};
+
+struct Options {
+	const char *input_path = nullptr;
+	int repeat = 1;
+	bool time = false;
+	bool stream = false;
+};
+
+inline void print_usage(const char *program, bool can_stream)
+{
+	std::println(std::cerr, "usage: {} [--repeat N] [--time]{} [input]", program,
+	             can_stream ? " [--stream]" : "");
+}
+
+// Parse command line, returns false on error
+inline bool parse_options(int argc, char *argv[], Options &options)
+{
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+
+		if (arg == "--time") {
+			options.time = true;
+		}
+		else if (arg == "--stream") {
+			options.stream = true;
+		}
+		else if (arg == "--repeat") {
+			if (++i == argc) {
+				return false;
+			}
+
+			std::string_view count = argv[i];
+
+			auto [ptr, ec] = std::from_chars(count.data(), count.data() + count.size(), options.repeat);
+
+			if (ec != std::errc{} || ptr != count.data() + count.size() || options.repeat < 1) {
+				return false;
+			}
+		}
+		else if (arg.starts_with("--") || options.input_path != nullptr) {
+			return false;
+		}
+		else {
+			options.input_path = argv[i];
+		}
+	}
+
+	return true;
+}
+
+#ifdef AOC_TRACK_ALLOCATIONS
+// Heap use of the runs of one phase, peak_heap is the most allocated at one
+// time during a run, above what was allocated when it started
+struct PhaseAllocs {
+	std::size_t allocations = 0;
+	std::size_t bytes = 0;
+	std::size_t peak_heap = 0;
+	std::size_t peak_rss = 0;
+};
+#endif
+
+// Durations of the runs of one phase, recording does not allocate
+class PhaseTimer {
+public:
+	// Call fn and record how long it took
+	template<typename Fn>
+	decltype(auto) measure(Fn &&fn)
+	{
+		struct Stop {
+			PhaseTimer *timer;
+#ifdef AOC_TRACK_ALLOCATIONS
+			AllocCount allocs_start = start_allocs();
+#endif
+#ifdef AOC_PERF_COUNTERS
+			PerfCount perf_start = perf_count();
+#endif
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			~Stop()
+			{
+				auto duration = std::chrono::steady_clock::now() - start;
+#ifdef AOC_PERF_COUNTERS
+				timer->add_perf(perf_start, perf_count());
+#endif
+#ifdef AOC_TRACK_ALLOCATIONS
+				timer->add_allocs(allocs_start, alloc_count());
+#endif
+				timer->add(duration);
+			}
+		} stop{this};
+
+		return std::forward<Fn>(fn)();
+	}
+
+	void add(std::chrono::nanoseconds duration)
+	{
+		min_duration = std::min(min_duration, duration);
+		max_duration = std::max(max_duration, duration);
+		total += duration;
+		++num_runs;
+	}
+
+	// Record the number of items processed by a run, for the throughput
+	void add_items(long count) { total_items += count; }
+
+	long runs() const { return num_runs; }
+	std::chrono::nanoseconds min() const { return min_duration; }
+	std::chrono::nanoseconds max() const { return max_duration; }
+	std::chrono::nanoseconds mean() const { return num_runs ? total / num_runs : total; }
+
+#ifdef AOC_TRACK_ALLOCATIONS
+	void add_allocs(const AllocCount &before, const AllocCount &after)
+	{
+		total_allocs.allocations += after.allocations - before.allocations;
+		total_allocs.bytes += after.bytes - before.bytes;
+		total_allocs.peak_heap = std::max(total_allocs.peak_heap,
+		                                  static_cast<std::size_t>(after.peak_bytes - before.live_bytes));
+		total_allocs.peak_rss = peak_rss();
+	}
+
+	// Allocations and bytes per run, and the highest peaks of any run
+	PhaseAllocs allocs() const
+	{
+		auto res = total_allocs;
+
+		if (num_runs != 0) {
+			res.allocations /= num_runs;
+			res.bytes /= num_runs;
+		}
+
+		return res;
+	}
+#endif
+
+#ifdef AOC_PERF_COUNTERS
+	void add_perf(const PerfCount &before, const PerfCount &after)
+	{
+		for (std::size_t i = 0; i < perf_total.size(); ++i) {
+			if (before[i] < 0 || after[i] < 0 || perf_total[i] < 0) {
+				perf_total[i] = -1;
+			}
+			else {
+				perf_total[i] += after[i] - before[i];
+			}
+		}
+	}
+
+	// Counts per run, -1 for counters that are not available
+	PerfCount perf() const
+	{
+		auto res = perf_total;
+
+		for (auto &count : res) {
+			if (count > 0 && num_runs != 0) {
+				count /= num_runs;
+			}
+		}
+
+		return res;
+	}
+#endif
+
+	void report(std::string_view phase) const
+	{
+		if (num_runs == 0) {
+			return;
+		}
+
+		std::println(std::cerr, "{:<6} runs {:>4}  min {:>12} ns  mean {:>12} ns  max {:>12} ns",
+		             phase, num_runs, min().count(), mean().count(), max().count());
+
+		if (total_items > 0) {
+			auto seconds = std::chrono::duration<double>(total).count();
+
+			std::println(std::cerr, "{:<6} items {:>11}  per second {:>12.0f}",
+			             "", total_items / num_runs, seconds > 0 ? total_items / seconds : 0.0);
+		}
+
+#ifdef AOC_TRACK_ALLOCATIONS
+		auto [allocations, bytes, peak_heap, peak_rss] = allocs();
+
+		std::println(std::cerr, "{:<6} allocs {:>10}  bytes {:>12}  peak heap {:>12}  peak rss {:>12}",
+		             "", allocations, bytes, peak_heap, peak_rss);
+#endif
+
+#ifdef AOC_PERF_COUNTERS
+		auto counts = perf();
+
+		std::print(std::cerr, "{:<6}", "");
+
+		for (std::size_t i = 0; i < counts.size(); ++i) {
+			if (counts[i] < 0) {
+				std::print(std::cerr, " {} n/a ", perf_event_names[i]);
+			}
+			else {
+				std::print(std::cerr, " {} {} ", perf_event_names[i], counts[i]);
+			}
+		}
+
+		// Instructions per cycle
+		if (counts[0] > 0 && counts[1] >= 0) {
+			std::print(std::cerr, " IPC {:.2f}", static_cast<double>(counts[1]) / counts[0]);
+		}
+
+		std::println(std::cerr, "");
+#endif
+	}
+
+private:
+#ifdef AOC_TRACK_ALLOCATIONS
+	static AllocCount start_allocs()
+	{
+		reset_alloc_peak();
+		return alloc_count();
+	}
+
+	PhaseAllocs total_allocs;
+#endif
+
+#ifdef AOC_PERF_COUNTERS
+	PerfCount perf_total = {};
+#endif
+
+	std::chrono::nanoseconds min_duration = std::chrono::nanoseconds::max();
+	std::chrono::nanoseconds max_duration{};
+	std::chrono::nanoseconds total{};
+	long total_items = 0;
+	long num_runs = 0;
+};
+
+// Timers for each phase of a solver
+struct Phases {
+	PhaseTimer parse;
+	PhaseTimer solve;
+	PhaseTimer output;
+
+	// Whether parse returned aoc::Unparsed, so solve includes the parsing
+	bool parse_in_solve = false;
+
+	void report() const
+	{
+		parse.report("parse");
+
+		if (parse_in_solve) {
+			std::println(std::cerr, "{:<6} input is parsed while solving, solve includes the parsing", "");
+		}
+
+		solve.report("solve");
+		output.report("output");
+	}
+};
+
+// Record the number of items processed, if the result counts them
+template<typename Result>
+void add_items(PhaseTimer &timer, const Result &result)
+{
+	if constexpr (requires { result.items(); }) {
+		timer.add_items(result.items());
+	}
+}
+
+// Parse and solve text once, and print the result to out unless it is null
+template<typename Parse, typename Solve, typename Print>
+void run_phases(std::string_view text, Parse parse, Solve solve, Print print,
+                std::FILE *out, Phases &phases)
+{
+	Scanner in(text);
+
+	auto data = phases.parse.measure([&] { return parse(in); });
+
+	phases.parse_in_solve = std::is_same_v<decltype(data), Unparsed>;
+
+	auto result = phases.solve.measure([&] { return solve(std::move(data)); });
+
+	add_items(phases.solve, result);
+
+	if (out != nullptr) {
+		phases.output.measure([&] {
+			print(out, result);
+			std::fflush(out);
+		});
+	}
+}
+
+// Run stream on the input file or stdin, and print the result of the last run
+template<typename Stream, typename Print>
+int run_stream(const Options &options, Stream stream, Print print)
+{
+	std::FILE *in = options.input_path != nullptr ? std::fopen(options.input_path, "rb") : stdin;
+
+	if (in == nullptr) {
+		std::println(std::cerr, "unable to read '{}'", options.input_path);
+		return 1;
+	}
+
+	Phases phases;
+
+	for (int i = 1; i <= options.repeat; ++i) {
+		// Each run reads the input again from the start
+		if (i > 1 && std::fseek(in, 0, SEEK_SET) != 0) {
+			std::println(std::cerr, "--repeat with --stream needs an input file");
+			return 1;
+		}
+
+		auto result = phases.solve.measure([&] { return stream(in); });
+
+		if (std::ferror(in)) {
+			std::println(std::cerr, "error reading input");
+			return 1;
+		}
+
+		add_items(phases.solve, result);
+
+		if (i == options.repeat) {
+			phases.output.measure([&] {
+				print(stdout, result);
+				std::fflush(stdout);
+			});
+		}
+	}
+
+	if (in != stdin) {
+		std::fclose(in);
+	}
+
+	if (options.time) {
+		phases.report();
+	}
+
+	return 0;
+}
+
+// Stream is std::nullptr_t for solvers that cannot stream their input
+template<typename Parse, typename Solve, typename Print, typename Stream = std::nullptr_t>
+int run(int argc, char *argv[], Parse parse, Solve solve, Print print, Stream stream = nullptr)
+{
+	constexpr bool can_stream = !std::is_null_pointer_v<Stream>;
+
+	Options options;
+
+	if (!parse_options(argc, argv, options) || (options.stream && !can_stream)) {
+		print_usage(argv[0], can_stream);
+		return 1;
+	}
+
+	try {
+		if constexpr (can_stream) {
+			if (options.stream) {
+				return run_stream(options, stream, print);
+			}
+		}
+
+		auto input = options.input_path != nullptr ? Input::from_file(options.input_path)
+		                                           : Input::from_stdin();
+
+		Phases phases;
+
+		for (int i = 1; i <= options.repeat; ++i) {
+			run_phases(input.text(), parse, solve, print, i == options.repeat ? stdout : nullptr, phases);
+		}
+
+		if (options.time) {
+			phases.report();
+		}
+	}
+	catch (const InputError &e) {
+		std::println(std::cerr, "{}", e.what());
+		return 1;
+	}
+
+	return 0;
+}
+
+// Input parsed once, so solve can be run on it repeatedly and timed on its
+// own
+class PreparedSolver {
+public:
+	virtual ~PreparedSolver() = default;
+
+	// Get a fresh copy of the parsed input ready for the next solve
+	virtual void reset() = 0;
+
+	// Solve the copy, returns the number of items processed, or -1 if the
+	// result does not count them
+	virtual long solve() = 0;
+};
+
+template<typename Parse, typename Solve>
+std::unique_ptr<PreparedSolver> prepare_solver(std::string_view text, Parse parse, Solve solve)
+{
+	using Data = decltype(parse(std::declval<Scanner &>()));
+	using Result = decltype(solve(std::declval<Data>()));
+
+	class Prepared : public PreparedSolver {
+	public:
+		Prepared(std::string_view text, Parse parse, Solve solve)
+			: text(text), parse_fn(parse), solve_fn(solve)
+		{
+			if constexpr (std::is_copy_constructible_v<Data>) {
+				parsed.emplace(parse_text());
+			}
+		}
+
+		void reset() override
+		{
+			result.reset();
+
+			// Data that cannot be copied is parsed again instead
+			if constexpr (std::is_copy_constructible_v<Data>) {
+				data.emplace(*parsed);
+			}
+			else {
+				data.emplace(parse_text());
+			}
+		}
+
+		long solve() override
+		{
+			// Keep the result, so the work is not optimized away
+			result.emplace(solve_fn(std::move(*data)));
+
+			if constexpr (requires { result->items(); }) {
+				return result->items();
+			}
+			else {
+				return -1;
+			}
+		}
+
+	private:
+		Data parse_text()
+		{
+			Scanner in(text);
+			return parse_fn(in);
+		}
+
+		std::string_view text;
+		Parse parse_fn;
+		Solve solve_fn;
+		std::optional<Data> parsed;
+		std::optional<Data> data;
+		std::optional<Result> result;
+	};
+
+	return std::make_unique<Prepared>(text, parse, solve);
+}
+
+// Solver linked into a program with other days
+struct Solver {
+	std::string_view name;
+	void (*run)(std::string_view text, std::FILE *out, Phases &phases);
+	std::unique_ptr<PreparedSolver> (*prepare)(std::string_view text);
+};
+
+inline std::vector<Solver> &solver_registry()
+{
+	static std::vector<Solver> registry;
+	return registry;
+}
+
+// All registered solvers, sorted by name
+inline std::span<const Solver> solvers()
+{
+	auto &registry = solver_registry();
+
+	std::ranges::sort(registry, {}, &Solver::name);
+
+	return registry;
+}
+
+inline const Solver *find_solver(std::string_view name)
+{
+	auto it = std::ranges::find(solvers(), name, &Solver::name);
+
+	return it != solvers().end() ? &*it : nullptr;
+}
+
+struct SolverRegistration {
+	explicit SolverRegistration(Solver solver)
+	{
+		solver_registry().push_back(solver);
+	}
+};
+
+} // namespace aoc
+
+#ifdef AOC_SOLVER_NAME
+#  define AOC_SOLVER(parse, solve, print) \
+	static const aoc::SolverRegistration aoc_solver_registration{{ \
+		AOC_SOLVER_NAME, \
+		[](std::string_view text, std::FILE *out, aoc::Phases &phases) { \
+			aoc::run_phases(text, parse, solve, print, out, phases); \
+		}, \
+		[](std::string_view text) { \
+			return aoc::prepare_solver(text, parse, solve); \
+		} \
+	}};
+// The linked programs always load the input, so stream is not called
+#  define AOC_STREAMING_SOLVER(parse, solve, print, stream) \
+	AOC_SOLVER(parse, solve, print) \
+	[[maybe_unused]] static const auto aoc_solver_stream = stream;
+#else
+#  define AOC_SOLVER(parse, solve, print) \
+	int main(int argc, char *argv[]) \
+	{ \
+		return aoc::run(argc, argv, parse, solve, print); \
+	}
+#  define AOC_STREAMING_SOLVER(parse, solve, print, stream) \
+	int main(int argc, char *argv[]) \
+	{ \
+		return aoc::run(argc, argv, parse, solve, print, stream); \
+	}
+#endif
+
+#endif // AOC_SOLVER_H_INCLUDED
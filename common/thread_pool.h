@@ -0,0 +1,358 @@
+//
+// Advent of Code 2024, work-stealing thread pool
+//
+// Each worker has its own queue of tasks. A worker takes tasks from the
+// back of its own queue, which keeps related work on the thread that made
+// it, and when that is empty steals from the front of the other queues.
+// Tasks submitted from outside the pool are spread over the queues.
+//
+// wait() blocks until every task submitted so far has finished, and runs
+// tasks on the calling thread meanwhile. Since it waits for all tasks, it
+// must not be called from inside one.
+//
+// If a task throws, the exception is kept and the other tasks still run.
+// wait() then rethrows the first one, like aoc::InputError from a solver
+// parsing part of its input on the pool, so it reaches the caller instead
+// of ending the program.
+//
+// wait_until() instead runs tasks until a condition holds, for callers
+// that wait for their own tasks while others use the pool at the same time.
+//
+// parallel_for() splits a range of indices into chunks and runs a function
+// on each chunk on the pool. It only waits for its own chunks, and only
+// passes on their exceptions. With AOC_PERF_COUNTERS, it also adds the
+// hardware counts of the chunks run on other threads to the calling thread
+// (see perf_counters.h), since the pool threads do not exit.
+//
+// shared_pool() is a pool with a thread per core, made on first use and
+// kept for the rest of the process, which the solvers that split their
+// work run on. Repeated runs then do not start threads again, and solvers
+// running at the same time in one process share the threads instead of
+// each starting as many as there are cores.
+//
+// use_parallel() decides whether work is large enough to split. Programs
+// built with AOC_TEST_PARALLEL split any work, on at least four threads,
+// so the tests can check the parallel paths on small inputs.
+//
+
+#ifndef AOC_THREAD_POOL_H_INCLUDED
+#define AOC_THREAD_POOL_H_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef AOC_PERF_COUNTERS
+#  include "perf_counters.h"
+#endif
+
+namespace aoc {
+
+class ThreadPool {
+public:
+	explicit ThreadPool(unsigned num_threads = std::thread::hardware_concurrency())
+	{
+		num_threads = std::max(num_threads, 1U);
+
+		for (unsigned i = 0; i < num_threads; ++i) {
+			queues.push_back(std::make_unique<Queue>());
+		}
+
+		for (unsigned i = 0; i < num_threads; ++i) {
+			threads.emplace_back([this, i] { work(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	// Finishes the tasks already submitted before stopping the workers, an
+	// exception from one of them that was not passed on by wait() is dropped
+	~ThreadPool()
+	{
+		finish();
+
+		{
+			std::lock_guard lock(mutex);
+			stopping = true;
+		}
+
+		work_available.notify_all();
+
+		for (auto &thread : threads) {
+			thread.join();
+		}
+	}
+
+	std::size_t size() const { return threads.size(); }
+
+	void submit(std::function<void()> task)
+	{
+		// Workers keep their own tasks, others are dealt out in turn
+		std::size_t index = current_pool == this ? current_worker : next_queue++ % queues.size();
+
+		{
+			std::lock_guard lock(queues[index]->mutex);
+			queues[index]->tasks.push_back(std::move(task));
+		}
+
+		{
+			std::lock_guard lock(mutex);
+			++num_queued;
+			++num_pending;
+		}
+
+		work_available.notify_one();
+	}
+
+	// Wait for all submitted tasks to finish, running tasks meanwhile, and
+	// rethrow the first exception thrown by one of them
+	void wait()
+	{
+		if (auto exception = finish()) {
+			std::rethrow_exception(exception);
+		}
+	}
+
+	// Run tasks until done() returns true, done() is called with the pool
+	// locked, and again after each task finishes
+	template<typename Done>
+	void wait_until(Done done)
+	{
+		std::unique_lock lock(mutex);
+
+		++num_waiting;
+
+		while (!done()) {
+			if (num_queued != 0) {
+				--num_queued;
+				lock.unlock();
+				run_task(current_pool == this ? current_worker : 0);
+				lock.lock();
+			}
+			else {
+				work_available.wait(lock);
+			}
+		}
+
+		--num_waiting;
+	}
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	// Wait for all submitted tasks to finish, and take the first exception
+	// thrown by one of them, if any
+	std::exception_ptr finish()
+	{
+		std::unique_lock lock(mutex);
+
+		while (num_pending != 0) {
+			if (num_queued != 0) {
+				--num_queued;
+				lock.unlock();
+				run_task(0);
+				lock.lock();
+			}
+			else {
+				work_available.wait(lock);
+			}
+		}
+
+		return std::exchange(first_exception, nullptr);
+	}
+
+	void work(std::size_t index)
+	{
+		current_pool = this;
+		current_worker = index;
+
+		std::unique_lock lock(mutex);
+
+		for (;;) {
+			work_available.wait(lock, [&] { return num_queued != 0 || stopping; });
+
+			if (num_queued == 0) {
+				return;
+			}
+
+			--num_queued;
+			lock.unlock();
+			run_task(index);
+			lock.lock();
+		}
+	}
+
+	// Run one task, the caller has reserved it by decrementing num_queued
+	void run_task(std::size_t index)
+	{
+		std::function<void()> task;
+
+		// A reserved task is in one of the queues, so this terminates
+		while (!take(index, task)) {
+			std::this_thread::yield();
+		}
+
+		std::exception_ptr exception;
+
+		try {
+			task();
+		}
+		catch (...) {
+			exception = std::current_exception();
+		}
+
+		bool done = false;
+
+		{
+			std::lock_guard lock(mutex);
+
+			if (exception && !first_exception) {
+				first_exception = exception;
+			}
+
+			done = --num_pending == 0 || num_waiting != 0;
+		}
+
+		// Wake waiters, who share the condition variable with idle workers
+		if (done) {
+			work_available.notify_all();
+		}
+	}
+
+	// Take a task from the back of our own queue, or steal one from the
+	// front of another
+	bool take(std::size_t index, std::function<void()> &task)
+	{
+		for (std::size_t i = 0; i < queues.size(); ++i) {
+			auto &queue = *queues[(index + i) % queues.size()];
+
+			std::lock_guard lock(queue.mutex);
+
+			if (queue.tasks.empty()) {
+				continue;
+			}
+
+			if (i == 0) {
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			}
+			else {
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> threads;
+
+	std::mutex mutex;
+	std::condition_variable work_available;
+	std::size_t num_queued = 0;
+	std::size_t num_pending = 0;
+	std::size_t num_waiting = 0;
+	std::exception_ptr first_exception;
+	std::atomic<std::size_t> next_queue = 0;
+	bool stopping = false;
+
+	static inline thread_local const ThreadPool *current_pool = nullptr;
+	static inline thread_local std::size_t current_worker = 0;
+};
+
+// Split [0, size) into num_chunks ranges of about equal size, and call
+// fn(chunk, begin, end) for each on the pool, returning when all are done.
+// If fn throws, the first exception is rethrown once all chunks are done.
+template<typename Fn>
+void parallel_for(ThreadPool &pool, std::size_t size, std::size_t num_chunks, Fn fn)
+{
+	std::atomic<std::size_t> num_left = num_chunks;
+	std::atomic<bool> failed = false;
+	std::exception_ptr exception;
+
+#ifdef AOC_PERF_COUNTERS
+	// Chunks run by the caller are in its own counts already
+	const auto caller = std::this_thread::get_id();
+	std::mutex perf_mutex;
+	PerfCount offloaded = {};
+#endif
+
+	for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+		pool.submit([&, chunk] {
+#ifdef AOC_PERF_COUNTERS
+			const bool offload = std::this_thread::get_id() != caller;
+			const auto perf_before = offload ? perf_count() : PerfCount{};
+#endif
+
+			try {
+				fn(chunk, size * chunk / num_chunks, size * (chunk + 1) / num_chunks);
+			}
+			catch (...) {
+				if (!failed.exchange(true)) {
+					exception = std::current_exception();
+				}
+			}
+
+#ifdef AOC_PERF_COUNTERS
+			if (offload) {
+				auto perf_after = perf_count();
+
+				std::lock_guard lock(perf_mutex);
+				add_perf_difference(offloaded, perf_before, perf_after);
+			}
+#endif
+
+			// Last, since the caller may return as soon as this is zero
+			--num_left;
+		});
+	}
+
+	pool.wait_until([&] { return num_left == 0; });
+
+#ifdef AOC_PERF_COUNTERS
+	add_offloaded_perf(offloaded);
+#endif
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+#ifdef AOC_TEST_PARALLEL
+inline constexpr bool test_parallel = true;
+#else
+inline constexpr bool test_parallel = false;
+#endif
+
+inline ThreadPool &shared_pool()
+{
+	static ThreadPool pool(test_parallel ? std::max(std::thread::hardware_concurrency(), 4U)
+	                                     : std::thread::hardware_concurrency());
+	return pool;
+}
+
+// Whether to split work of size items, at least min_size, on shared_pool()
+inline bool use_parallel(std::size_t size, std::size_t min_size)
+{
+	return test_parallel || (size >= min_size && std::thread::hardware_concurrency() > 1);
+}
+
+} // namespace aoc
+
+#endif // AOC_THREAD_POOL_H_INCLUDED
@@ -0,0 +1,407 @@
+//
+// Advent of Code 2024, multi-pattern grid search
+//
+// WordSearch looks for many patterns in a grid of characters at once, like
+// the XMAS puzzle of day 4. A pattern is either a word read in a straight
+// line, in any of the directions of aoc::directions8 allowed for it, or a
+// stencil, a small block of letters with '.' matching any cell.
+//
+// The words are compiled into an Aho-Corasick automaton holding each word
+// both forwards and reversed. The grid is then scanned along its rows,
+// columns and both diagonals in one pass each, so each line finds every
+// word in both directions. Scanning costs the same no matter how many
+// words there are, apart from the matches reported.
+//
+// Stencils are matched by checking their letters at every position. Added
+// with rotations, the stencil also matches when turned by 90, 180 or 270
+// degrees, which for instance makes the X-shaped MAS of day 4 a single
+// pattern.
+//
+
+#ifndef AOC_WORD_SEARCH_H_INCLUDED
+#define AOC_WORD_SEARCH_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "grid.h"
+
+namespace aoc {
+
+// Bit i stands for directions8[i]
+inline constexpr unsigned all_directions = 0xFF;
+
+inline unsigned direction_bit(int dx, int dy)
+{
+	for (std::size_t i = 0; i < directions8.size(); ++i) {
+		if (directions8[i][0] == dx && directions8[i][1] == dy) {
+			return 1U << i;
+		}
+	}
+
+	return 0;
+}
+
+// Pattern found at (x, y). For words that is the first letter, read in
+// direction (dx, dy). For stencils it is the top left corner, and (dx, dy)
+// is (0, 0).
+struct PatternMatch {
+	int pattern = 0;
+	int x = 0;
+	int y = 0;
+	int dx = 0;
+	int dy = 0;
+};
+
+struct SearchResult {
+	// Number of matches of each pattern
+	std::vector<long> counts;
+
+	// Every match, if positions were asked for, ordered by line
+	std::vector<PatternMatch> matches;
+};
+
+class WordSearch {
+public:
+	// Look for word in the directions given by the bits of directions,
+	// returns the pattern number
+	int add_word(std::string_view word, unsigned directions = all_directions)
+	{
+		words.push_back({std::string(word), directions, num_patterns()});
+		built = false;
+
+		return num_patterns() - 1;
+	}
+
+	// Look for the block of letters given by rows, where '.' matches any
+	// cell, returns the pattern number
+	int add_stencil(const std::vector<std::string> &rows, bool rotations = false)
+	{
+		auto pattern = num_patterns();
+
+		std::vector<std::string> block = rows;
+
+		for (int turn = 0; turn < (rotations ? 4 : 1); ++turn) {
+			auto same = [&](const Stencil &stencil) {
+				return stencil.pattern == pattern && stencil.rows == block;
+			};
+
+			// Symmetric stencils turn into themselves
+			if (std::ranges::none_of(stencils, same)) {
+				stencils.push_back({block, pattern});
+			}
+
+			block = rotate(block);
+		}
+
+		++num_stencils;
+
+		return pattern;
+	}
+
+	int num_patterns() const
+	{
+		return static_cast<int>(words.size()) + num_stencils;
+	}
+
+	// Find all patterns in the cells of grid, and if positions is true
+	// record where each match is
+	SearchResult search(const Grid<char> &grid, bool positions = false)
+	{
+		if (!built) {
+			build();
+		}
+
+		SearchResult result;
+
+		result.counts.assign(num_patterns(), 0);
+
+		const int width = grid.width();
+		const int height = grid.height();
+
+		// Each line is given by its first cell and step, the reversed words
+		// find matches going the other way
+		auto scan_lines = [&](int dx, int dy, auto &&starts) {
+			unsigned needed = direction_bit(dx, dy) | direction_bit(-dx, -dy);
+
+			if ((used_directions & needed) == 0) {
+				return;
+			}
+
+			for (auto [x0, y0] : starts) {
+				scan_line(grid, x0, y0, dx, dy, positions, result);
+			}
+		};
+
+		std::vector<std::array<int, 2>> starts;
+
+		// Rows
+		for (int y = 0; y < height; ++y) {
+			starts.push_back({0, y});
+		}
+
+		scan_lines(1, 0, starts);
+
+		// Columns
+		starts.clear();
+
+		for (int x = 0; x < width; ++x) {
+			starts.push_back({x, 0});
+		}
+
+		scan_lines(0, 1, starts);
+
+		// Diagonals down and right, starting from the top and left edges
+		for (int y = 1; y < height; ++y) {
+			starts.push_back({0, y});
+		}
+
+		scan_lines(1, 1, starts);
+
+		// Diagonals down and left, starting from the top and right edges
+		starts.resize(width);
+
+		for (int y = 1; y < height; ++y) {
+			starts.push_back({width - 1, y});
+		}
+
+		scan_lines(-1, 1, starts);
+
+		for (const auto &stencil : stencils) {
+			match_stencil(grid, stencil, positions, result);
+		}
+
+		return result;
+	}
+
+private:
+	struct Word {
+		std::string text;
+		unsigned directions;
+		int pattern;
+	};
+
+	struct Stencil {
+		std::vector<std::string> rows;
+		int pattern;
+	};
+
+	// Word ending at a node of the automaton
+	struct Output {
+		int word;
+		bool reversed;
+	};
+
+	// Turn rows a quarter clockwise, padding short rows with '.'
+	static std::vector<std::string> rotate(const std::vector<std::string> &rows)
+	{
+		std::size_t width = 0;
+
+		for (const auto &row : rows) {
+			width = std::max(width, row.size());
+		}
+
+		std::vector<std::string> res(width, std::string(rows.size(), '.'));
+
+		for (std::size_t y = 0; y < rows.size(); ++y) {
+			for (std::size_t x = 0; x < rows[y].size(); ++x) {
+				res[x][rows.size() - 1 - y] = rows[y][x];
+			}
+		}
+
+		return res;
+	}
+
+	// Build the trie of all words forwards and reversed, and turn it into a
+	// complete transition table using the failure links
+	void build()
+	{
+		classes.fill(0);
+		num_classes = 1;
+
+		for (const auto &word : words) {
+			for (unsigned char c : word.text) {
+				if (classes[c] == 0) {
+					classes[c] = num_classes++;
+				}
+			}
+		}
+
+		next.assign(num_classes, 0);
+		outputs.clear();
+		used_directions = 0;
+
+		std::vector<std::vector<Output>> node_outputs(1);
+
+		for (int i = 0; i < static_cast<int>(words.size()); ++i) {
+			if (words[i].text.empty()) {
+				continue;
+			}
+
+			used_directions |= words[i].directions;
+
+			for (bool reversed : {false, true}) {
+				std::string text = words[i].text;
+
+				if (reversed) {
+					std::ranges::reverse(text);
+				}
+
+				int node = 0;
+
+				for (unsigned char c : text) {
+					auto &child = next[node * num_classes + classes[c]];
+
+					if (child == 0) {
+						child = static_cast<int>(node_outputs.size());
+						node_outputs.emplace_back();
+						next.resize(next.size() + num_classes, 0);
+					}
+
+					node = next[node * num_classes + classes[c]];
+				}
+
+				node_outputs[node].push_back({i, reversed});
+			}
+		}
+
+		const auto num_nodes = node_outputs.size();
+
+		// Breadth first, so the failure target of a node is done before it
+		std::vector<int> fail(num_nodes, 0);
+
+		dict_link.assign(num_nodes, -1);
+
+		std::queue<int> queue;
+
+		for (int c = 1; c < num_classes; ++c) {
+			if (auto child = next[c]; child != 0) {
+				queue.push(child);
+			}
+		}
+
+		while (!queue.empty()) {
+			int node = queue.front();
+			queue.pop();
+
+			dict_link[node] = node_outputs[fail[node]].empty() ? dict_link[fail[node]] : fail[node];
+
+			for (int c = 1; c < num_classes; ++c) {
+				auto &child = next[node * num_classes + c];
+
+				if (child != 0) {
+					fail[child] = next[fail[node] * num_classes + c];
+					queue.push(child);
+				}
+				else {
+					child = next[fail[node] * num_classes + c];
+				}
+			}
+		}
+
+		// Flatten the outputs, each node lists its own then follows dict_link
+		first_output.assign(num_nodes + 1, 0);
+
+		for (std::size_t node = 0; node < num_nodes; ++node) {
+			first_output[node + 1] = first_output[node] + static_cast<int>(node_outputs[node].size());
+			outputs.insert(outputs.end(), node_outputs[node].begin(), node_outputs[node].end());
+		}
+
+		built = true;
+	}
+
+	void scan_line(const Grid<char> &grid, int x0, int y0, int dx, int dy,
+	               bool positions, SearchResult &result) const
+	{
+		const unsigned forward = direction_bit(dx, dy);
+		const unsigned backward = direction_bit(-dx, -dy);
+
+		int state = 0;
+
+		for (int x = x0, y = y0, t = 0; grid.contains(x, y); x += dx, y += dy, ++t) {
+			state = next[state * num_classes + classes[static_cast<unsigned char>(grid(x, y))]];
+
+			for (int node = state; node != -1; node = dict_link[node]) {
+				for (int k = first_output[node]; k < first_output[node + 1]; ++k) {
+					const auto &[word_index, reversed] = outputs[k];
+					const auto &word = words[word_index];
+
+					if ((word.directions & (reversed ? backward : forward)) == 0) {
+						continue;
+					}
+
+					++result.counts[word.pattern];
+
+					if (positions) {
+						// A reversed match starts at the current cell
+						int back = reversed ? 0 : static_cast<int>(word.text.size()) - 1;
+
+						result.matches.push_back({
+							word.pattern, x - back * dx, y - back * dy,
+							reversed ? -dx : dx, reversed ? -dy : dy
+						});
+					}
+				}
+			}
+		}
+	}
+
+	static void match_stencil(const Grid<char> &grid, const Stencil &stencil,
+	                          bool positions, SearchResult &result)
+	{
+		const auto &rows = stencil.rows;
+
+		const int height = static_cast<int>(rows.size());
+		int width = 0;
+
+		for (const auto &row : rows) {
+			width = std::max(width, static_cast<int>(row.size()));
+		}
+
+		for (int y = 0; y + height <= grid.height(); ++y) {
+			for (int x = 0; x + width <= grid.width(); ++x) {
+				bool found = true;
+
+				for (int sy = 0; sy < height && found; ++sy) {
+					for (int sx = 0; sx < static_cast<int>(rows[sy].size()); ++sx) {
+						if (rows[sy][sx] != '.' && rows[sy][sx] != grid(x + sx, y + sy)) {
+							found = false;
+							break;
+						}
+					}
+				}
+
+				if (found) {
+					++result.counts[stencil.pattern];
+
+					if (positions) {
+						result.matches.push_back({stencil.pattern, x, y, 0, 0});
+					}
+				}
+			}
+		}
+	}
+
+	std::vector<Word> words;
+	std::vector<Stencil> stencils;
+	int num_stencils = 0;
+
+	// Automaton, rebuilt when words were added since the last search
+	bool built = false;
+	std::array<int, 256> classes = {};
+	int num_classes = 1;
+	std::vector<int> next;
+	std::vector<int> dict_link;
+	std::vector<int> first_output;
+	std::vector<Output> outputs;
+	unsigned used_directions = 0;
+};
+
+} // namespace aoc
+
+#endif // AOC_WORD_SEARCH_H_INCLUDED
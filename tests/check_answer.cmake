@@ -0,0 +1,64 @@
+# Run PROGRAM on INPUT with --time, and fail if the output differs from the
+# file EXPECTED, or if the fastest parse plus the fastest solve took longer
+# than BUDGET_MS milliseconds scaled by BUDGET_PERCENT
+#
+# Usage: cmake -DPROGRAM=... -DINPUT=... -DEXPECTED=... [-DBUDGET_MS=...]
+#              [-DBUDGET_PERCENT=...] [-DARGS=...] -P check_answer.cmake
+#
+# ARGS holds extra options for PROGRAM, like --stream
+
+if(NOT BUDGET_PERCENT)
+	set(BUDGET_PERCENT 100)
+endif()
+
+# Repeat quick programs to get a more stable minimum time
+set(repeat 3)
+
+if(BUDGET_MS GREATER 1000)
+	set(repeat 1)
+endif()
+
+execute_process(
+	COMMAND "${PROGRAM}" ${ARGS} --repeat ${repeat} --time "${INPUT}"
+	OUTPUT_VARIABLE output
+	ERROR_VARIABLE timings
+	RESULT_VARIABLE result
+)
+
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "${PROGRAM} failed (${result})\n${timings}")
+endif()
+
+file(READ "${EXPECTED}" expected)
+
+string(REPLACE "\r\n" "\n" output "${output}")
+string(REPLACE "\r\n" "\n" expected "${expected}")
+
+if(NOT output STREQUAL expected)
+	message(FATAL_ERROR "wrong output\n--- expected\n${expected}--- got\n${output}")
+endif()
+
+if(NOT BUDGET_MS)
+	message(STATUS "output correct, no budget")
+	return()
+endif()
+
+set(total_ns 0)
+
+foreach(phase parse solve)
+	if(NOT timings MATCHES "${phase} +runs +[0-9]+ +min +([0-9]+) ns")
+		message(FATAL_ERROR "no ${phase} time in\n${timings}")
+	endif()
+
+	math(EXPR total_ns "${total_ns} + ${CMAKE_MATCH_1}")
+endforeach()
+
+math(EXPR budget_ns "${BUDGET_MS} * 1000000 / 100 * ${BUDGET_PERCENT}")
+math(EXPR total_ms "${total_ns} / 1000000")
+
+if(total_ns GREATER budget_ns)
+	math(EXPR budget_ms "${budget_ns} / 1000000")
+	message(FATAL_ERROR "took ${total_ms} ms, over the budget of ${budget_ms} ms")
+endif()
+
+message(STATUS "output correct, ${total_ms} ms (budget ${BUDGET_MS} ms at ${BUDGET_PERCENT}%)")
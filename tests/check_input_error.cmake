@@ -0,0 +1,26 @@
+# Run PROGRAM with ARGS on input it must reject, and fail unless it exits
+# with status 1 and writes a message matching ERROR to stderr, instead of
+# crashing or printing an answer
+#
+# Usage: cmake -DPROGRAM=... -DARGS=... -DERROR=... -P check_input_error.cmake
+#
+# ARGS are the arguments joined with '|', like GRID|XMAS
+
+string(REPLACE "|" ";" ARGS "${ARGS}")
+
+execute_process(
+	COMMAND "${PROGRAM}" ${ARGS}
+	OUTPUT_VARIABLE output
+	ERROR_VARIABLE errors
+	RESULT_VARIABLE result
+)
+
+if(NOT result EQUAL 1)
+	message(FATAL_ERROR "expected exit status 1, got ${result}\n--- stdout\n${output}--- stderr\n${errors}")
+endif()
+
+if(NOT errors MATCHES "${ERROR}")
+	message(FATAL_ERROR "expected an error matching '${ERROR}'\n--- stderr\n${errors}")
+endif()
+
+message(STATUS "rejected: ${errors}")
@@ -0,0 +1,62 @@
+# Run word_search with ARGS, and fail unless the counts it prints for the
+# patterns add up to the answer in the day 4 output file EXPECTED, which is
+# its first number. With --positions, there must be one position listed for
+# each match.
+#
+# Usage: cmake -DPROGRAM=... -DEXPECTED=... -DARGS=... -P check_word_search.cmake
+#
+# ARGS are the arguments joined with '|', like GRID|--rotate|M.S/.A./M.S
+
+string(REPLACE "|" ";" ARGS "${ARGS}")
+
+file(READ "${EXPECTED}" expected)
+
+if(NOT expected MATCHES "([0-9]+)")
+	message(FATAL_ERROR "no answer in ${EXPECTED}")
+endif()
+
+set(answer ${CMAKE_MATCH_1})
+
+execute_process(
+	COMMAND "${PROGRAM}" ${ARGS}
+	OUTPUT_VARIABLE output
+	ERROR_VARIABLE errors
+	RESULT_VARIABLE result
+)
+
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "${PROGRAM} failed (${result})\n${errors}")
+endif()
+
+string(REPLACE "\r\n" "\n" output "${output}")
+string(REGEX MATCHALL "[^\n]+" lines "${output}")
+
+set(total 0)
+set(num_patterns 0)
+set(num_positions 0)
+
+foreach(line IN LISTS lines)
+	# Match positions are indented, counts are not
+	if(line MATCHES "^[^ ].* ([0-9]+)$")
+		math(EXPR total "${total} + ${CMAKE_MATCH_1}")
+		math(EXPR num_patterns "${num_patterns} + 1")
+	elseif(line MATCHES "^  -?[0-9]+ -?[0-9]+ -?[0-9]+ -?[0-9]+$")
+		math(EXPR num_positions "${num_positions} + 1")
+	endif()
+endforeach()
+
+if(num_patterns EQUAL 0)
+	message(FATAL_ERROR "no counts in output\n${output}")
+endif()
+
+if(NOT total EQUAL answer)
+	message(FATAL_ERROR "counts add up to ${total}, expected ${answer}\n${output}")
+endif()
+
+list(FIND ARGS "--positions" positions_index)
+
+if(positions_index GREATER -1 AND NOT num_positions EQUAL total)
+	message(FATAL_ERROR "${num_positions} positions listed for ${total} matches")
+endif()
+
+message(STATUS "counts add up to ${answer}")
@@ -0,0 +1,154 @@
+//
+// Advent of Code 2024, thread pool test
+//
+// Checks that an exception thrown by a task reaches the caller of wait()
+// and parallel_for() once the other tasks are done, with one thread and
+// with several, and that the pool can be used and destroyed afterwards.
+// Also checks that parallel_for() called from several threads at once on
+// one pool only passes an exception on to the call it came from.
+//
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <print>
+#include <string_view>
+#include <thread>
+
+#include "input.h"
+#include "thread_pool.h"
+
+namespace {
+
+int num_failed = 0;
+
+void check(bool ok, unsigned num_threads, std::string_view what)
+{
+	if (!ok) {
+		std::println(std::cerr, "{} threads: {}", num_threads, what);
+		++num_failed;
+	}
+}
+
+void test_pool(unsigned num_threads)
+{
+	constexpr std::size_t num_chunks = 16;
+
+	aoc::ThreadPool pool(num_threads);
+
+	// parallel_for runs every chunk and then rethrows
+	std::atomic<std::size_t> num_run = 0;
+	bool caught = false;
+
+	try {
+		aoc::parallel_for(pool, 100, num_chunks, [&](auto chunk, auto, auto) {
+			++num_run;
+
+			if (chunk % 5 == 1) {
+				throw aoc::InputError("bad chunk");
+			}
+		});
+	}
+	catch (const aoc::InputError &e) {
+		caught = std::string_view(e.what()) == "bad chunk";
+	}
+
+	check(caught, num_threads, "parallel_for did not rethrow the exception");
+	check(num_run == num_chunks, num_threads, "parallel_for did not run every chunk");
+
+	// wait rethrows an exception from a submitted task once
+	caught = false;
+
+	pool.submit([] { throw aoc::InputError("bad task"); });
+	pool.submit([] {});
+
+	try {
+		pool.wait();
+	}
+	catch (const aoc::InputError &) {
+		caught = true;
+	}
+
+	check(caught, num_threads, "wait did not rethrow the exception");
+
+	try {
+		pool.wait();
+	}
+	catch (...) {
+		check(false, num_threads, "wait rethrew an exception twice");
+	}
+
+	// The pool still works afterwards
+	num_run = 0;
+
+	aoc::parallel_for(pool, 100, num_chunks, [&](auto, auto begin, auto end) {
+		num_run += end - begin;
+	});
+
+	check(num_run == 100, num_threads, "parallel_for failed after an exception");
+
+	// Destroying the pool finishes a throwing task without terminating
+	pool.submit([] { throw aoc::InputError("not waited for"); });
+}
+
+void test_shared(unsigned num_threads)
+{
+	aoc::ThreadPool pool(num_threads);
+
+	bool caught_bad = false;
+	bool caught_good = false;
+	std::size_t sum = 0;
+
+	std::thread bad([&] {
+		try {
+			aoc::parallel_for(pool, 1000, 50, [](auto chunk, auto, auto) {
+				if (chunk == 7) {
+					throw aoc::InputError("bad chunk");
+				}
+			});
+		}
+		catch (const aoc::InputError &) {
+			caught_bad = true;
+		}
+	});
+
+	std::thread good([&] {
+		std::atomic<std::size_t> total = 0;
+
+		try {
+			aoc::parallel_for(pool, 1000, 50, [&](auto, auto begin, auto end) {
+				total += end - begin;
+			});
+		}
+		catch (...) {
+			caught_good = true;
+		}
+
+		sum = total;
+	});
+
+	bad.join();
+	good.join();
+
+	check(caught_bad, num_threads, "concurrent parallel_for did not rethrow its exception");
+	check(!caught_good, num_threads, "concurrent parallel_for got an exception of another");
+	check(sum == 1000, num_threads, "concurrent parallel_for did not run every chunk");
+}
+
+} // namespace
+
+int main()
+{
+	for (unsigned num_threads : { 1U, 4U }) {
+		test_pool(num_threads);
+		test_shared(num_threads);
+	}
+
+	if (num_failed != 0) {
+		return 1;
+	}
+
+	std::println("thread pool tests passed");
+
+	return 0;
+}
@@ -0,0 +1,89 @@
+//
+// Advent of Code 2024, synthetic input generator
+//
+// Writes a synthetic input for the given day to stdout, see generate.h.
+// The size defaults to about that of the puzzle input, and the same seed
+// always gives the same input.
+//
+// usage: generate DAY [--size N] [--seed N]
+//        generate --list
+//
+
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <print>
+#include <string_view>
+
+#include "generate.h"
+
+namespace {
+
+template<typename T>
+bool parse_number(std::string_view str, T &value)
+{
+	auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+
+	return ec == std::errc{} && ptr == str.data() + str.size();
+}
+
+void list_generators()
+{
+	std::println("day  default size  size is");
+
+	for (const auto &generator : aoc::generators) {
+		std::println("{:>3}  {:>12}  {}", generator.day, generator.default_size, generator.size_meaning);
+	}
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	if (argc == 2 && std::string_view(argv[1]) == "--list") {
+		list_generators();
+		return 0;
+	}
+
+	int day = 0;
+	long size = 0;
+	unsigned long seed = 2024;
+
+	bool ok = argc >= 2 && parse_number(std::string_view(argv[1]), day);
+
+	for (int i = 2; ok && i < argc; i += 2) {
+		std::string_view arg = argv[i];
+
+		if (i + 1 == argc) {
+			ok = false;
+		}
+		else if (arg == "--size") {
+			ok = parse_number(std::string_view(argv[i + 1]), size) && size > 0;
+		}
+		else if (arg == "--seed") {
+			ok = parse_number(std::string_view(argv[i + 1]), seed);
+		}
+		else {
+			ok = false;
+		}
+	}
+
+	if (!ok) {
+		std::println(std::cerr, "usage: {} DAY [--size N] [--seed N]", argv[0]);
+		std::println(std::cerr, "       {} --list", argv[0]);
+		return 1;
+	}
+
+	const auto *generator = aoc::find_generator(day);
+
+	if (generator == nullptr) {
+		std::println(std::cerr, "no generator for day {}", day);
+		return 1;
+	}
+
+	aoc::Rng rng(seed);
+
+	auto input = generator->generate(rng, size != 0 ? size : generator->default_size);
+
+	std::fwrite(input.data(), 1, input.size(), stdout);
+}
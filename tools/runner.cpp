@@ -0,0 +1,341 @@
+//
+// Advent of Code 2024, all days in one process
+//
+// Runs the selected solvers on their puzzle inputs, named by day in the
+// inputs directory (01.txt to 25.txt), and prints the answers followed by
+// a table of how long each phase took. Solvers are selected by name
+// prefix, so dec202406 selects both parts of day 6, and with none given
+// all solvers that have an input are run.
+//
+// By default the solvers run one after another. With --parallel they run
+// concurrently on a thread pool, and the time of each solver then also
+// includes the effects of sharing the machine with the others.
+//
+// A solver that rejects its input is reported and left out of the tables,
+// the others still run.
+//
+// usage: runner [--parallel] [--threads N] [--inputs DIR] [--quiet] [NAME...]
+//
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "input.h"
+#include "solver.h"
+#include "thread_pool.h"
+
+namespace {
+
+struct Options {
+	std::vector<std::string_view> names;
+	const char *inputs_dir = "inputs";
+	unsigned threads = 0;
+	bool parallel = false;
+	bool quiet = false;
+};
+
+struct Task {
+	const aoc::Solver *solver = nullptr;
+	std::string_view input;
+	aoc::Phases phases;
+	std::chrono::nanoseconds total{};
+	std::string output;
+	std::string error;
+};
+
+bool parse_options(int argc, char *argv[], Options &options)
+{
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+
+		if (arg == "--parallel") {
+			options.parallel = true;
+		}
+		else if (arg == "--quiet") {
+			options.quiet = true;
+		}
+		else if (arg == "--threads" || arg == "--inputs") {
+			if (++i == argc) {
+				return false;
+			}
+
+			if (arg == "--inputs") {
+				options.inputs_dir = argv[i];
+				continue;
+			}
+
+			std::string_view count = argv[i];
+
+			auto [ptr, ec] = std::from_chars(count.data(), count.data() + count.size(), options.threads);
+
+			if (ec != std::errc{} || ptr != count.data() + count.size() || options.threads < 1) {
+				return false;
+			}
+
+			options.parallel = true;
+		}
+		else if (arg.starts_with("--")) {
+			return false;
+		}
+		else {
+			options.names.push_back(arg);
+		}
+	}
+
+	return true;
+}
+
+bool selected(std::string_view name, const Options &options)
+{
+	return options.names.empty() || std::ranges::any_of(options.names, [&](auto prefix) {
+		return name.starts_with(prefix);
+	});
+}
+
+// Run the solver, collecting what it prints so concurrent solvers do not
+// mix their output, or why it rejected the input
+void run_task(Task &task)
+{
+	std::FILE *out = std::tmpfile();
+
+	if (out == nullptr) {
+		std::println(std::cerr, "unable to create temporary file");
+		std::exit(1);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	try {
+		task.solver->run(task.input, out, task.phases);
+	}
+	catch (const aoc::InputError &e) {
+		task.error = e.what();
+	}
+
+	task.total = std::chrono::steady_clock::now() - start;
+
+	std::rewind(out);
+
+	char buffer[4096];
+
+	for (std::size_t num_read; (num_read = std::fread(buffer, 1, sizeof(buffer), out)) != 0; ) {
+		task.output.append(buffer, num_read);
+	}
+
+	std::fclose(out);
+}
+
+double to_ms(std::chrono::nanoseconds duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void print_table(const std::vector<Task> &tasks, std::chrono::nanoseconds load_time,
+                 std::chrono::nanoseconds wall_time, unsigned num_threads)
+{
+	std::println("{:<12}  {:>10}  {:>10}  {:>10}  {:>10}  {:>10}",
+	             "solver", "bytes", "parse ms", "solve ms", "output ms", "total ms");
+	std::println("{:-<72}", "");
+
+	std::chrono::nanoseconds sum{};
+
+	for (const auto &task : tasks) {
+		// Days that parse while solving have their parse time in solve
+		auto parse_ms = task.phases.parse_in_solve ? std::string("in solve")
+		                                           : std::format("{:.3f}", to_ms(task.phases.parse.mean()));
+
+		std::println("{:<12}  {:>10}  {:>10}  {:>10.3f}  {:>10.3f}  {:>10.3f}",
+		             task.solver->name, task.input.size(), parse_ms, to_ms(task.phases.solve.mean()),
+		             to_ms(task.phases.output.mean()), to_ms(task.total));
+
+		sum += task.total;
+	}
+
+	std::println("{:-<72}", "");
+	std::println("{:<12}  {:>58.3f}", "sum", to_ms(sum));
+	std::println("{:<12}  {:>58.3f}", "load inputs", to_ms(load_time));
+	std::println("{:<12}  {:>58.3f}", std::format("wall ({}T)", num_threads), to_ms(wall_time));
+}
+
+#ifdef AOC_TRACK_ALLOCATIONS
+// Allocations and peak RSS are for the whole process, so they include the
+// threads each solver starts, and with --parallel any solvers running at
+// the same time. Peak RSS also includes the inputs.
+void print_allocs_table(const std::vector<Task> &tasks)
+{
+	std::println("{:<12}  {:>12}  {:>12}  {:>12}  {:>12}  {:>12}  {:>12}",
+	             "solver", "parse allocs", "parse bytes", "solve allocs", "solve bytes", "peak heap", "peak rss");
+	std::println("{:-<96}", "");
+
+	for (const auto &task : tasks) {
+		auto parse = task.phases.parse.allocs();
+		auto solve = task.phases.solve.allocs();
+
+		std::println("{:<12}  {:>12}  {:>12}  {:>12}  {:>12}  {:>12}  {:>12}",
+		             task.solver->name, parse.allocations, parse.bytes, solve.allocations, solve.bytes,
+		             std::max(parse.peak_heap, solve.peak_heap), std::max(parse.peak_rss, solve.peak_rss));
+	}
+}
+#endif
+
+#ifdef AOC_PERF_COUNTERS
+// Counters of the parse and solve phases, n/a where not available
+void print_perf_table(const std::vector<Task> &tasks)
+{
+	std::print("{:<18}", "solver");
+
+	for (auto name : aoc::perf_event_names) {
+		std::print("  {:>14}", name);
+	}
+
+	std::println("  {:>6}", "IPC");
+	std::println("{:-<106}", "");
+
+	for (const auto &task : tasks) {
+		for (auto [phase, timer] : { std::pair{"parse", &task.phases.parse}, std::pair{"solve", &task.phases.solve} }) {
+			auto counts = timer->perf();
+
+			std::print("{:<12} {:<5}", task.solver->name, phase);
+
+			for (auto count : counts) {
+				if (count < 0) {
+					std::print("  {:>14}", "n/a");
+				}
+				else {
+					std::print("  {:>14}", count);
+				}
+			}
+
+			if (counts[0] > 0 && counts[1] >= 0) {
+				std::println("  {:>6.2f}", static_cast<double>(counts[1]) / counts[0]);
+			}
+			else {
+				std::println("  {:>6}", "n/a");
+			}
+		}
+	}
+}
+#endif
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	Options options;
+
+	if (!parse_options(argc, argv, options)) {
+		std::println(std::cerr, "usage: {} [--parallel] [--threads N] [--inputs DIR] [--quiet] [NAME...]", argv[0]);
+		return 1;
+	}
+
+	if (!std::filesystem::is_directory(options.inputs_dir)) {
+		std::println(std::cerr, "no inputs directory '{}'", options.inputs_dir);
+		return 1;
+	}
+
+	auto wall_start = std::chrono::steady_clock::now();
+
+	// Load the input of each day once, both parts share it
+	std::vector<aoc::Input> inputs(26);
+
+	std::vector<Task> tasks;
+
+	for (const auto &solver : aoc::solvers()) {
+		if (!selected(solver.name, options)) {
+			continue;
+		}
+
+		auto day = aoc::to_number<int>(solver.name.substr(7, 2));
+
+		auto path = std::filesystem::path(options.inputs_dir) / std::format("{:02}.txt", day);
+
+		if (!std::filesystem::exists(path)) {
+			std::println(std::cerr, "skipping {}, no input '{}'", solver.name, path.string());
+			continue;
+		}
+
+		if (inputs[day].text().empty()) {
+			inputs[day] = aoc::Input::from_file(path.string().c_str());
+		}
+
+		Task task;
+
+		task.solver = &solver;
+		task.input = inputs[day].text();
+
+		tasks.push_back(std::move(task));
+	}
+
+	if (tasks.empty()) {
+		std::println(std::cerr, "no solvers to run");
+		return 1;
+	}
+
+	auto load_time = std::chrono::steady_clock::now() - wall_start;
+
+	unsigned num_threads = 1;
+
+	if (options.parallel) {
+		aoc::ThreadPool pool(options.threads != 0 ? options.threads : std::thread::hardware_concurrency());
+
+		num_threads = pool.size();
+
+		for (auto &task : tasks) {
+			pool.submit([&task] { run_task(task); });
+		}
+
+		pool.wait();
+	}
+	else {
+		for (auto &task : tasks) {
+			run_task(task);
+		}
+	}
+
+	auto wall_time = std::chrono::steady_clock::now() - wall_start;
+
+	auto num_failed = std::erase_if(tasks, [](const Task &task) {
+		if (task.error.empty()) {
+			return false;
+		}
+
+		std::println(std::cerr, "{}: {}", task.solver->name, task.error);
+
+		return true;
+	});
+
+	if (!options.quiet) {
+		for (const auto &task : tasks) {
+			std::println("{}:", task.solver->name);
+			std::print("{}", task.output);
+			std::println("");
+		}
+	}
+
+	print_table(tasks, load_time, wall_time, num_threads);
+
+#ifdef AOC_TRACK_ALLOCATIONS
+	std::println("");
+	print_allocs_table(tasks);
+#endif
+
+#ifdef AOC_PERF_COUNTERS
+	std::println("");
+	print_perf_table(tasks);
+#endif
+
+	return num_failed != 0 ? 1 : 0;
+}
@@ -0,0 +1,154 @@
+//
+// Advent of Code 2024, grid word search
+//
+// Counts each pattern in a grid of letters read from a file, see
+// word_search.h. A pattern is a word, or a stencil given as its rows
+// separated by '/', like M.S/.A./M.S for the X-shaped MAS of day 4.
+//
+// Words are looked for in the directions of the last --directions before
+// them, all eight by default, given as a comma separated list of right,
+// left, up, down, up-right, up-left, down-right and down-left. Stencils
+// after --rotate also match when turned. With --positions, every match is
+// listed after the count as x y dx dy, see PatternMatch.
+//
+// usage: word_search [--positions] GRID [--directions LIST] [--rotate] PATTERN...
+//
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <iostream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "grid.h"
+#include "input.h"
+#include "word_search.h"
+
+namespace {
+
+constexpr std::array<std::pair<std::string_view, std::array<int, 2>>, 8> direction_names = {{
+	{ "right", { 1, 0 } }, { "left", { -1, 0 } }, { "up", { 0, -1 } }, { "down", { 0, 1 } },
+	{ "up-right", { 1, -1 } }, { "up-left", { -1, -1 } },
+	{ "down-right", { 1, 1 } }, { "down-left", { -1, 1 } }
+}};
+
+// Mask of the directions in a comma separated list, 0 on errors
+unsigned parse_directions(std::string_view list)
+{
+	unsigned mask = 0;
+
+	while (!list.empty()) {
+		auto name = list.substr(0, list.find(','));
+
+		list.remove_prefix(std::min(list.size(), name.size() + 1));
+
+		auto it = std::ranges::find_if(direction_names, [&](const auto &entry) { return entry.first == name; });
+
+		if (it == direction_names.end()) {
+			return 0;
+		}
+
+		mask |= aoc::direction_bit(it->second[0], it->second[1]);
+	}
+
+	return mask;
+}
+
+std::vector<std::string> split_rows(std::string_view stencil)
+{
+	std::vector<std::string> rows;
+
+	for (;;) {
+		auto pos = stencil.find('/');
+
+		rows.emplace_back(stencil.substr(0, pos));
+
+		if (pos == std::string_view::npos) {
+			return rows;
+		}
+
+		stencil.remove_prefix(pos + 1);
+	}
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	bool positions = false;
+	const char *grid_path = nullptr;
+
+	unsigned directions = aoc::all_directions;
+	bool rotate = false;
+
+	aoc::WordSearch search;
+	std::vector<std::string_view> names;
+
+	bool ok = true;
+
+	for (int i = 1; ok && i < argc; ++i) {
+		std::string_view arg = argv[i];
+
+		if (arg == "--positions") {
+			positions = true;
+		}
+		else if (arg == "--rotate") {
+			rotate = true;
+		}
+		else if (arg == "--directions") {
+			ok = ++i < argc && (directions = parse_directions(argv[i])) != 0;
+		}
+		else if (arg.starts_with("--")) {
+			ok = false;
+		}
+		else if (grid_path == nullptr) {
+			grid_path = argv[i];
+		}
+		else if (arg.contains('/') || arg.contains('.')) {
+			search.add_stencil(split_rows(arg), rotate);
+			names.push_back(arg);
+		}
+		else {
+			search.add_word(arg, directions);
+			names.push_back(arg);
+		}
+	}
+
+	if (!ok || grid_path == nullptr || names.empty()) {
+		std::println(std::cerr, "usage: {} [--positions] GRID [--directions LIST] [--rotate] PATTERN...", argv[0]);
+		return 1;
+	}
+
+	auto input = aoc::Input::from_file(grid_path);
+
+	aoc::Scanner in(input.text());
+
+	aoc::Grid<char> grid;
+
+	// Lines of different lengths are rejected
+	try {
+		grid = aoc::read_grid(in);
+	}
+	catch (const aoc::InputError &e) {
+		std::println(std::cerr, "{}: {}", grid_path, e.what());
+		return 1;
+	}
+
+	auto result = search.search(grid, positions);
+
+	for (int pattern = 0; pattern < search.num_patterns(); ++pattern) {
+		std::println("{} {}", names[pattern], result.counts[pattern]);
+
+		for (const auto &match : result.matches) {
+			if (match.pattern == pattern) {
+				std::println("  {} {} {} {}", match.x, match.y, match.dx, match.dy);
+			}
+		}
+	}
+
+	return 0;
+}